@@ -19,17 +19,9 @@ Maintainer: Gregory Cristian & Gilbert Menth
 #include "Eeprom.h"
 #include "DemoApplication.h"
 #include "FreqLUT.h"
-
-double t0 =       -0.016432807883697;                         // X0
-double t1 =       0.323147003165358;                          // X1
-double t2 =       0.014922061351196;                          // X1^2
-double t3 =       0.000137832006285;                          // X1^3
-double t4 =       0.536873856625399;                          // X2
-double t5 =       0.040890089178579;                          // X2^2
-double t6 =       -0.001074801048732;                         // X2^3
-double t7 =       0.000009240142234;                          // X2^4
-
-
+// Shared with the C driver: RangingCalibFit writes this single copy
+#include "../../../SX1280_C_Lib/src/RangingCalibration.h"
+#include "RangingCorrection.h"
 
 /*!
  * \brief Defines the local payload buffer size
@@ -58,17 +50,6 @@ double t7 =       0.000009240142234;                          // X2^4
 #define RNG_TIMER_MS                    384 // ms
 #define RNG_COM_TIMEOUT                 100 // ms
 
-/*!
- * \brief Ranging raw factors
- *                                  SF5     SF6     SF7     SF8     SF9     SF10
- */
-const uint16_t RNG_CALIB_0400[] = { 10299,  10271,  10244,  10242,  10230,  10246  };
-const uint16_t RNG_CALIB_0800[] = { 11486,  11474,  11453,  11426,  11417,  11401  };
-const uint16_t RNG_CALIB_1600[] = { 13308,  13493,  13528,  13515,  13430,  13376  };
-const double   RNG_FGRAD_0400[] = { -0.148, -0.214, -0.419, -0.853, -1.686, -3.423 };
-const double   RNG_FGRAD_0800[] = { -0.041, -0.811, -0.218, -0.429, -0.853, -1.737 };
-const double   RNG_FGRAD_1600[] = { 0.103,  -0.041, -0.101, -0.211, -0.424, -0.87  };
-
 /*!
  * \brief Define the possible message type for the Ping-Pong and PER apps
  */
@@ -87,9 +68,16 @@ uint8_t Buffer[BUFFER_SIZE];
 static uint8_t CurrentChannel;
 static uint16_t MeasuredChannels;
 int RngResultIndex;
-double RawRngResults[DEMO_RNG_CHANNELS_COUNT_MAX];
+double RawRngResults[DEMO_RNG_CHANNELS_COUNT_MAX];              // kept in ascending order as they arrive
 double RssiRng[DEMO_RNG_CHANNELS_COUNT_MAX];
 
+/*!
+ * \brief Running mean and sum of the squared deviations of RawRngResults,
+ *        updated with Welford's method
+ */
+static double RngMean;
+static double RngM2;
+
 
 /*!
  * \brief Function to be executed on Radio Tx Done event
@@ -202,6 +190,17 @@ uint16_t GetTimeOnAir( uint8_t modulation );
 void SendNextPacketEvent( void );
 uint8_t CheckDistance( void );
 
+/*!
+ * \brief Clears the ranging results of the previous measure
+ */
+void RngResultsReset( void );
+
+/*!
+ * \brief Inserts a ranging result in RawRngResults and updates its mean and
+ *        variance, so that CheckDistance has nothing left to sort
+ */
+void RngResultAdd( double distance );
+
 // **************************     RF Test Demo    ******************************
 // *                                                                           *
 // *                                                                           *
@@ -1109,7 +1108,7 @@ uint8_t RunDemoApplicationRanging( void )
 
             case APP_RANGING_DONE:
                 TX_LED = 0;
-                RawRngResults[RngResultIndex++] = Radio.GetRangingResult( RANGING_RESULT_RAW );
+                RngResultAdd( Radio.GetRangingResult( RANGING_RESULT_RAW ) );
                 Eeprom.EepromData.DemoSettings.CntPacketRxOK++;
                 DemoInternalState = APP_RNG;
                 break;
@@ -1153,7 +1152,7 @@ uint8_t RunDemoApplicationRanging( void )
                         Radio.SetTxParams( Eeprom.EepromData.DemoSettings.TxPower, RADIO_RAMP_20_US );
 
                         MeasuredChannels = 0;
-                        RngResultIndex   = 0;
+                        RngResultsReset( );
                         SendNextPacket.attach_us( &SendNextPacketEvent, Eeprom.EepromData.DemoSettings.RngReqDelay * 1000 );
                         DemoInternalState = APP_RNG;
                     }
@@ -1800,25 +1799,15 @@ void InitializeDemoParameters( uint8_t modulation )
         Radio.SetTxParams( Eeprom.EepromData.DemoSettings.TxPower, RADIO_RAMP_20_US );
         memcpy( &( ModulationParams.Params.LoRa.SpreadingFactor ), Eeprom.Buffer + MOD_RNG_SPREADF_EEPROM_ADDR, 1 );
         memcpy( &( ModulationParams.Params.LoRa.Bandwidth ),       Eeprom.Buffer + MOD_RNG_BW_EEPROM_ADDR,      1 );
-        switch( ModulationParams.Params.LoRa.Bandwidth )
-        {
-            case LORA_BW_0400:
-                Eeprom.EepromData.DemoSettings.RngCalib     = RNG_CALIB_0400[ ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) - 5 ];
-                Eeprom.EepromData.DemoSettings.RngFeiFactor = ( double )RNG_FGRAD_0400[ ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) - 5 ];
-                Eeprom.EepromData.DemoSettings.RngReqDelay  = RNG_TIMER_MS >> ( 0 + 10 - ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) );
-                break;
+        // Same tables as the C library, generated by RangingCalibFit
+        uint8_t row = RangingCalibrationRow( ModulationParams.Params.LoRa.Bandwidth );
+        uint8_t column = RangingCalibrationColumn( ModulationParams.Params.LoRa.SpreadingFactor );
 
-            case LORA_BW_0800:
-                Eeprom.EepromData.DemoSettings.RngCalib     = RNG_CALIB_0800[ ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) - 5 ];
-                Eeprom.EepromData.DemoSettings.RngFeiFactor = ( double )RNG_FGRAD_0800[ ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) - 5 ];
-                Eeprom.EepromData.DemoSettings.RngReqDelay  = RNG_TIMER_MS >> ( 1 + 10 - ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) );
-                break;
-
-            case LORA_BW_1600:
-                Eeprom.EepromData.DemoSettings.RngCalib     = RNG_CALIB_1600[ ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) - 5 ];
-                Eeprom.EepromData.DemoSettings.RngFeiFactor = ( double )RNG_FGRAD_1600[ ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) - 5 ];
-                Eeprom.EepromData.DemoSettings.RngReqDelay  = RNG_TIMER_MS >> ( 2 + 10 - ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) );
-                break;
+        if( ( row < RANGING_CALIBRATION_BW_COUNT ) && ( column < RANGING_CALIBRATION_SF_COUNT ) )
+        {
+            Eeprom.EepromData.DemoSettings.RngCalib     = RangingCalibrations[row][column];
+            Eeprom.EepromData.DemoSettings.RngFeiFactor = ( double )RangingFeiGradients[row][column] / 1000.0;
+            Eeprom.EepromData.DemoSettings.RngReqDelay  = RNG_TIMER_MS >> ( row + 10 - ( ModulationParams.Params.LoRa.SpreadingFactor >> 4 ) );
         }
         Radio.SetInterruptMode( );
     }
@@ -1853,48 +1842,105 @@ void SendNextPacketEvent( void )
     }
 }
 
+void RngResultsReset( void )
+{
+    RngResultIndex = 0;
+    RngMean = 0.0;
+    RngM2 = 0.0;
+}
+
+/*!
+ * \brief Index of the first result greater than distance, or greater or
+ *        equal when inclusive is false
+ */
+static int RngResultBound( double distance, bool inclusive )
+{
+    int low = 0;
+    int high = RngResultIndex;
+
+    while( low < high )
+    {
+        int middle = ( low + high ) / 2;
+
+        if( ( RawRngResults[middle] < distance ) || ( inclusive && ( RawRngResults[middle] == distance ) ) )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void RngResultAdd( double distance )
+{
+    int index;
+    double delta;
+
+    if( RngResultIndex >= DEMO_RNG_CHANNELS_COUNT_MAX )
+    {
+        return;
+    }
+    index = RngResultBound( distance, true );
+    memmove( &RawRngResults[index + 1], &RawRngResults[index], ( RngResultIndex - index ) * sizeof( double ) );
+    RawRngResults[index] = distance;
+    RngResultIndex++;
+
+    delta = distance - RngMean;
+    RngMean += delta / RngResultIndex;
+    RngM2 += delta * ( distance - RngMean );
+}
+
 uint8_t CheckDistance( void )
 {
     double displayRange = 0.0;
-    double rssi = Eeprom.EepromData.DemoSettings.RssiValue;
+    int8_t rssi = Eeprom.EepromData.DemoSettings.RssiValue;
 
     uint16_t j = 0;
-    uint16_t i;
 
     printf( "#id: %d", Eeprom.EepromData.DemoSettings.CntPacketTx );
     if( RngResultIndex > 0 )
     {
-        for( i = 0; i < RngResultIndex; ++i )
-        {
-            RawRngResults[i] = RawRngResults[i] - ( Eeprom.EepromData.DemoSettings.RngFeiFactor * Eeprom.EepromData.DemoSettings.RngFei / 1000 );
-        }
+        // The results are already sorted, the z-score window widens from
+        // DEMO_RNG_ZSCORE_MIN until enough results fall inside
+        double stdDev = sqrt( RngM2 / RngResultIndex );
+        int first = 0;
+        int last = RngResultIndex;
 
-        for (int i = RngResultIndex - 1; i > 0; --i) 
+        for( uint8_t z = DEMO_RNG_ZSCORE_MIN; z <= DEMO_RNG_ZSCORE_MAX; z++ )
         {
-            for (int j = 0; j < i; ++j) 
+            first = RngResultBound( RngMean - z * stdDev, false );
+            last = RngResultBound( RngMean + z * stdDev, true );
+            if( ( last - first ) >= DEMO_RNG_CHANNELS_COUNT_MIN )
             {
-                if (RawRngResults[j] > RawRngResults[j+1]) 
-                {
-                    int temp = RawRngResults[j];
-                    RawRngResults[j] = RawRngResults[j+1];
-                    RawRngResults[j+1] = temp;
-                }
+                break;
             }
         }
+        if( first == last )
+        {
+            first = 0;
+            last = RngResultIndex;
+        }
+        j = last - first;
+
         double median;
-        if ((RngResultIndex % 2) == 0) 
+        if( ( j % 2 ) == 0 )
         {
-            median = (RawRngResults[RngResultIndex/2] + RawRngResults[(RngResultIndex/2) - 1])/2.0;
-        } 
-        else 
+            median = ( RawRngResults[first + j / 2] + RawRngResults[first + j / 2 - 1] ) / 2.0;
+        }
+        else
         {
-            median = RawRngResults[RngResultIndex/2];
+            median = RawRngResults[first + j / 2];
         }
+        // The frequency error correction is the same for every result
+        median -= Eeprom.EepromData.DemoSettings.RngFeiFactor * Eeprom.EepromData.DemoSettings.RngFei / 1000;
 
         if( median < 50 )
         {
             // Apply the short range correction and RSSI short range improvement below 50 m
-            displayRange = t0 + t1 * rssi + t2 * pow(rssi,2) + t3 * pow(rssi, 3) +t4 * median + t5 * pow(median,2) + t6 * pow(median, 3) + t7 * pow(median, 4) ;       
+            displayRange = ShortRangeCorrection( ( int32_t )floor( median * 256.0 + 0.5 ), rssi ) / 256.0;
         }
         else
         {
@@ -0,0 +1,74 @@
+/*
+  ______                              _
+ / _____)             _              | |
+( (____  _____ ____ _| |_ _____  ____| |__
+ \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ _____) ) ____| | | || |_| ____( (___| | | |
+(______/|_____)_|_|_| \__)_____)\____)_| |_|
+    (C)2016 Semtech
+
+Description: Short range correction of the ranging demo, kept apart so the
+             host harness Simulator/SimShortRange can check it.
+
+Maintainer: Gregory Cristian & Gilbert Menth
+*/
+
+#ifndef RANGING_CORRECTION_H
+#define RANGING_CORRECTION_H
+
+#include <stdint.h>
+
+/*!
+ * \brief Short range correction coefficients in Q27.36, the median distance d
+ *        in meters and the RSSI r in dBm giving
+ *        t0 + t1 * r + t2 * r^2 + t3 * r^3 + t4 * d + t5 * d^2 + t6 * d^3 + t7 * d^4
+ */
+static const int64_t RngCorrection[8] =
+{
+    -1129253959LL,                                          // X0, -0.016432807883697
+    22206492966LL,                                          // X1, 0.323147003165358
+    1025436248LL,                                           // X1^2, 0.014922061351196
+    9471743LL,                                              // X1^3, 0.000137832006285
+    36893690501LL,                                          // X2, 0.536873856625399
+    2809945532LL,                                           // X2^2, 0.040890089178579
+    -73859766LL,                                            // X2^3, -0.001074801048732
+    634978LL,                                               // X2^4, 0.000009240142234
+};
+
+/*!
+ * \brief Range of the distances, in 1/256 m, the short range correction
+ *        applies to
+ */
+#define RNG_CORRECTION_MAX              ( 50 * 256 )
+#define RNG_CORRECTION_MIN              ( -128 * 256 )
+
+/*!
+ * \brief Applies the short range correction to a distance in 1/256 m,
+ *        evaluated with Horner's scheme on 64-bit integers
+ */
+static inline int32_t ShortRangeCorrection( int32_t distance, int8_t rssi )
+{
+    int64_t acc;
+    int64_t sum;
+
+    if( ( distance > RNG_CORRECTION_MAX ) || ( distance < RNG_CORRECTION_MIN ) )
+    {
+        return distance;
+    }
+
+    acc = RngCorrection[7];
+    acc = ( ( acc * distance ) >> 8 ) + RngCorrection[6];
+    acc = ( ( acc * distance ) >> 8 ) + RngCorrection[5];
+    acc = ( ( acc * distance ) >> 8 ) + RngCorrection[4];
+    sum = ( acc * distance ) >> 8;
+
+    acc = RngCorrection[3];
+    acc = acc * rssi + RngCorrection[2];
+    acc = acc * rssi + RngCorrection[1];
+    acc = acc * rssi + RngCorrection[0];
+    sum += acc;
+
+    return ( int32_t )( ( sum + ( ( int64_t )1 << 27 ) ) >> 28 );
+}
+
+#endif // RANGING_CORRECTION_H
@@ -201,7 +201,16 @@ void SX1280::SetRfFrequency( uint32_t rfFrequency )
     uint8_t buf[3];
     uint32_t freq = 0;
 
+#if SX1280_INTEGER_FREQUENCY
+    // Both products fit in 64 bits, and only the low 32 bits of the second
+    // one fall below the shift
+    uint64_t high = ( uint64_t )rfFrequency * FREQ_STEP_MULTIPLIER_HIGH;
+    uint64_t low = ( uint64_t )rfFrequency * FREQ_STEP_MULTIPLIER_LOW;
+
+    freq = ( uint32_t )( ( high + ( low >> 32 ) ) >> ( FREQ_STEP_SHIFT - 32 ) );
+#else
     freq = ( uint32_t )( ( double )rfFrequency / ( double )FREQ_STEP );
+#endif
     buf[0] = ( uint8_t )( ( freq >> 16 ) & 0xFF );
     buf[1] = ( uint8_t )( ( freq >> 8 ) & 0xFF );
     buf[2] = ( uint8_t )( freq & 0xFF );
@@ -301,6 +310,8 @@ void SX1280::SetPacketParams( PacketParams_t *packetParams )
             break;
         case PACKET_TYPE_LORA:
         case PACKET_TYPE_RANGING:
+            this->LoRaHeaderType = packetParams->Params.LoRa.HeaderType;
+            this->LoRaPayloadLength = packetParams->Params.LoRa.PayloadLength;
             buf[0] = packetParams->Params.LoRa.PreambleLength;
             buf[1] = packetParams->Params.LoRa.HeaderType;
             buf[2] = packetParams->Params.LoRa.PayloadLength;
@@ -546,6 +557,55 @@ uint8_t SX1280::GetPayload( uint8_t *buffer, uint8_t *size , uint8_t maxSize )
     return 0;
 }
 
+uint8_t SX1280::ReadRxFrame( RxFrame_t *frame, uint8_t *payload, uint8_t maxSize )
+{
+    uint8_t status[2];
+    uint8_t result = 0;
+
+    frame->IrqStatus = GetIrqStatus( );
+    ReadCommand( RADIO_GET_RXBUFFERSTATUS, status, 2 );
+
+    // Same rules as GetRxBufferStatus, but the LORA header mode and fixed
+    // length come from the local copy of the packet parameters instead of
+    // two more register reads
+    if( ( this->PacketType == PACKET_TYPE_LORA ) && ( this->LoRaHeaderType == LORA_PACKET_FIXED_LENGTH ) )
+    {
+        frame->Size = this->LoRaPayloadLength;
+    }
+    else if( this->PacketType == PACKET_TYPE_BLE )
+    {
+        frame->Size = status[0] + 2;
+    }
+    else
+    {
+        frame->Size = status[0];
+    }
+
+    if( frame->Size > maxSize )
+    {
+        result = 1;
+    }
+    else
+    {
+        ReadBuffer( status[1], payload, frame->Size );
+    }
+    GetPacketStatus( &frame->PacketStatus );
+
+    frame->FrequencyError = 0.0;
+    if( ( this->PacketType == PACKET_TYPE_LORA ) || ( this->PacketType == PACKET_TYPE_RANGING ) )
+    {
+        // Same conversion as GetFrequencyError, from a single 3 bytes read
+        uint8_t efeRaw[3];
+        uint32_t efe;
+
+        ReadRegister( REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB, efeRaw, 3 );
+        efe = ( efeRaw[0] << 16 ) | ( efeRaw[1] << 8 ) | efeRaw[2];
+        efe &= REG_LR_ESTIMATED_FREQUENCY_ERROR_MASK;
+        frame->FrequencyError = 1.55 * ( double )complement2( efe, 20 ) / ( 1600.0 / ( double )this->GetLoRaBandwidth( ) * 1000.0 );
+    }
+    return result;
+}
+
 void SX1280::SendPayload( uint8_t *payload, uint8_t size, TickTime_t timeout, uint8_t offset )
 {
     SetPayload( payload, size, offset );
@@ -895,6 +955,125 @@ void SX1280::OnDioIrq( void )
     }
 }
 
+/*!
+ * \brief What ProcessIrqs does for one asserted IRQ bit
+ */
+typedef enum
+{
+    IRQ_ACTION_NONE                         = 0x00,
+    IRQ_ACTION_TX_DONE,
+    IRQ_ACTION_TX_TIMEOUT,
+    IRQ_ACTION_RX_DONE,                             //!< rxDone, or rxError on CRC or sync word error
+    IRQ_ACTION_RX_DONE_LORA,                        //!< rxDone, or rxError on CRC error
+    IRQ_ACTION_RX_TIMEOUT,                          //!< rxTimeout, unless a CAD completed
+    IRQ_ACTION_SYNCWORD_VALID,
+    IRQ_ACTION_SYNCWORD_ERROR,
+    IRQ_ACTION_HEADER_VALID,
+    IRQ_ACTION_HEADER_ERROR,
+    IRQ_ACTION_RANGING_ON_LORA,
+    IRQ_ACTION_CAD_DONE,
+    IRQ_ACTION_RANGING_SLAVE_ERROR,
+    IRQ_ACTION_RANGING_SLAVE_VALID,
+    IRQ_ACTION_RANGING_MASTER_ERROR,
+    IRQ_ACTION_RANGING_MASTER_VALID,
+}IrqActions_t;
+
+/*!
+ * \brief Places the 4-bit action of one IRQ bit at the position of that bit
+ */
+static constexpr uint64_t IrqEntry( uint16_t irq, IrqActions_t action )
+{
+    return ( uint64_t )action << ( 4 * __builtin_ctz( irq ) );
+}
+
+/*!
+ * \brief Computes the mask of the IRQ bits having an action in a row
+ */
+static constexpr uint16_t IrqRowMask( uint64_t actions, uint8_t bit = 0 )
+{
+    return ( bit == 16 ) ? 0 : ( ( ( ( actions >> ( 4 * bit ) ) & 0x0F ) != 0 ) ? ( 1 << bit ) : 0 ) | IrqRowMask( actions, bit + 1 );
+}
+
+/*!
+ * \brief Extracts the action of one IRQ bit, when the table is built
+ */
+static constexpr uint8_t IrqRowAction( uint64_t actions, uint8_t bit )
+{
+    return ( actions >> ( 4 * bit ) ) & 0x0F;
+}
+
+/*!
+ * \brief The actions of the 16 IRQ bits for one packet type and operating
+ * mode, one byte per bit so the decoder reads them without shifting
+ */
+typedef struct
+{
+    uint8_t Actions[16];                            //!< Action per IRQ bit
+    uint16_t Mask;                                  //!< IRQ bits having an action
+}IrqDispatchRow_t;
+
+#define IRQ_ROW( actions )                          { { IrqRowAction( actions, 0 ), IrqRowAction( actions, 1 ), IrqRowAction( actions, 2 ), \
+                                                        IrqRowAction( actions, 3 ), IrqRowAction( actions, 4 ), IrqRowAction( actions, 5 ), \
+                                                        IrqRowAction( actions, 6 ), IrqRowAction( actions, 7 ), IrqRowAction( actions, 8 ), \
+                                                        IrqRowAction( actions, 9 ), IrqRowAction( actions, 10 ), IrqRowAction( actions, 11 ), \
+                                                        IrqRowAction( actions, 12 ), IrqRowAction( actions, 13 ), IrqRowAction( actions, 14 ), \
+                                                        IrqRowAction( actions, 15 ) }, IrqRowMask( actions ) }
+
+/*!
+ * \brief Packet types and operating modes handled by the IRQ dispatch table
+ */
+#define IRQ_CLASS_FSK                               0   // GFSK, FLRC and BLE
+#define IRQ_CLASS_LORA                              1
+#define IRQ_CLASS_RANGING                           2
+#define IRQ_CLASS_COUNT                             3
+
+#define IRQ_MODE_RX                                 0
+#define IRQ_MODE_TX                                 1
+#define IRQ_MODE_CAD                                2
+#define IRQ_MODE_COUNT                              3
+
+/*!
+ * \brief IRQ dispatch table, indexed by packet type class and operating mode,
+ * the actions of a status running from its lowest bit up
+ */
+static const IrqDispatchRow_t IrqDispatchTable[IRQ_CLASS_COUNT][IRQ_MODE_COUNT] =
+{
+    // IRQ_CLASS_FSK
+    {
+        IRQ_ROW( IrqEntry( IRQ_RX_DONE, IRQ_ACTION_RX_DONE ) |
+                 IrqEntry( IRQ_SYNCWORD_VALID, IRQ_ACTION_SYNCWORD_VALID ) |
+                 IrqEntry( IRQ_SYNCWORD_ERROR, IRQ_ACTION_SYNCWORD_ERROR ) |
+                 IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RX_TIMEOUT ) ),
+        IRQ_ROW( IrqEntry( IRQ_TX_DONE, IRQ_ACTION_TX_DONE ) |
+                 IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_TX_TIMEOUT ) ),
+        IRQ_ROW( 0 ),
+    },
+    // IRQ_CLASS_LORA
+    {
+        IRQ_ROW( IrqEntry( IRQ_RX_DONE, IRQ_ACTION_RX_DONE_LORA ) |
+                 IrqEntry( IRQ_HEADER_VALID, IRQ_ACTION_HEADER_VALID ) |
+                 IrqEntry( IRQ_HEADER_ERROR, IRQ_ACTION_HEADER_ERROR ) |
+                 IrqEntry( IRQ_RANGING_SLAVE_REQUEST_DISCARDED, IRQ_ACTION_RANGING_ON_LORA ) |
+                 IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RX_TIMEOUT ) ),
+        IRQ_ROW( IrqEntry( IRQ_TX_DONE, IRQ_ACTION_TX_DONE ) |
+                 IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_TX_TIMEOUT ) ),
+        IRQ_ROW( IrqEntry( IRQ_CAD_DONE, IRQ_ACTION_CAD_DONE ) |
+                 IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RX_TIMEOUT ) ),
+    },
+    // IRQ_CLASS_RANGING: MODE_RX is the slave side, MODE_TX the master side
+    {
+        IRQ_ROW( IrqEntry( IRQ_HEADER_VALID, IRQ_ACTION_HEADER_VALID ) |
+                 IrqEntry( IRQ_HEADER_ERROR, IRQ_ACTION_HEADER_ERROR ) |
+                 IrqEntry( IRQ_RANGING_SLAVE_RESPONSE_DONE, IRQ_ACTION_RANGING_SLAVE_VALID ) |
+                 IrqEntry( IRQ_RANGING_SLAVE_REQUEST_DISCARDED, IRQ_ACTION_RANGING_SLAVE_ERROR ) |
+                 IrqEntry( IRQ_RANGING_SLAVE_REQUEST_VALID, IRQ_ACTION_RANGING_SLAVE_VALID ) |
+                 IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RANGING_SLAVE_ERROR ) ),
+        IRQ_ROW( IrqEntry( IRQ_RANGING_MASTER_RESULT_VALID, IRQ_ACTION_RANGING_MASTER_VALID ) |
+                 IrqEntry( IRQ_RANGING_MASTER_TIMEOUT, IRQ_ACTION_RANGING_MASTER_ERROR ) ),
+        IRQ_ROW( 0 ),
+    },
+};
+
 void SX1280::ProcessIrqs( void )
 {
     RadioPacketTypes_t packetType = PACKET_TYPE_NONE;
@@ -930,250 +1109,175 @@ void SX1280::ProcessIrqs( void )
     TEST_PIN_2 = 0;
 #endif
 
+    uint8_t irqClass;
+    uint8_t irqMode;
+
     switch( packetType )
     {
         case PACKET_TYPE_GFSK:
         case PACKET_TYPE_FLRC:
         case PACKET_TYPE_BLE:
-            switch( OperatingMode )
-            {
-                case MODE_RX:
-                    if( ( irqRegs & IRQ_RX_DONE ) == IRQ_RX_DONE )
-                    {
-                        if( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
-                        {
-                            if( rxError != NULL )
-                            {
-                                rxError( IRQ_CRC_ERROR_CODE );
-                            }
-                        }
-                        else if( ( irqRegs & IRQ_SYNCWORD_ERROR ) == IRQ_SYNCWORD_ERROR )
-                        {
-                            if( rxError != NULL )
-                            {
-                                rxError( IRQ_SYNCWORD_ERROR_CODE );
-                            }
-                        }
-                        else
-                        {
-                            if( rxDone != NULL )
-                            {
-                                rxDone( );
-                            }
-                        }
-                    }
-                    if( ( irqRegs & IRQ_SYNCWORD_VALID ) == IRQ_SYNCWORD_VALID )
-                    {
-                        if( rxSyncWordDone != NULL )
-                        {
-                            rxSyncWordDone( );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_SYNCWORD_ERROR ) == IRQ_SYNCWORD_ERROR )
-                    {
-                        if( rxError != NULL )
-                        {
-                            rxError( IRQ_SYNCWORD_ERROR_CODE );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
-                    {
-                        if( rxTimeout != NULL )
-                        {
-                            rxTimeout( );
-                        }
-                    }
-                    break;
-                case MODE_TX:
-                    if( ( irqRegs & IRQ_TX_DONE ) == IRQ_TX_DONE )
-                    {
-                        if( txDone != NULL )
-                        {
-                            txDone( );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
-                    {
-                        if( txTimeout != NULL )
-                        {
-                            txTimeout( );
-                        }
-                    }
-                    break;
-                default:
-                    // Unexpected IRQ: silently returns
-                    break;
-            }
+            irqClass = IRQ_CLASS_FSK;
             break;
         case PACKET_TYPE_LORA:
-            switch( OperatingMode )
-            {
-                case MODE_RX:
-                    if( ( irqRegs & IRQ_RX_DONE ) == IRQ_RX_DONE )
-                    {
-                        if( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
-                        {
-                            if( rxError != NULL )
-                            {
-                                rxError( IRQ_CRC_ERROR_CODE );
-                            }
-                        }
-                        else
-                        {
-                            if( rxDone != NULL )
-                            {
-                                rxDone( );
-                            }
-                        }
-                    }
-                    if( ( irqRegs & IRQ_HEADER_VALID ) == IRQ_HEADER_VALID )
-                    {
-                        if( rxHeaderDone != NULL )
-                        {
-                            rxHeaderDone( );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_HEADER_ERROR ) == IRQ_HEADER_ERROR )
-                    {
-                        if( rxError != NULL )
-                        {
-                            rxError( IRQ_HEADER_ERROR_CODE );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
-                    {
-                        if( rxTimeout != NULL )
-                        {
-                            rxTimeout( );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RANGING_SLAVE_REQUEST_DISCARDED ) == IRQ_RANGING_SLAVE_REQUEST_DISCARDED )
-                    {
-                        if( rxError != NULL )
-                        {
-                            rxError( IRQ_RANGING_ON_LORA_ERROR_CODE );
-                        }
-                    }
-                    break;
-                case MODE_TX:
-                    if( ( irqRegs & IRQ_TX_DONE ) == IRQ_TX_DONE )
-                    {
-                        if( txDone != NULL )
-                        {
-                            txDone( );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
-                    {
-                        if( txTimeout != NULL )
-                        {
-                            txTimeout( );
-                        }
-                    }
-                    break;
-                case MODE_CAD:
-                    if( ( irqRegs & IRQ_CAD_DONE ) == IRQ_CAD_DONE )
-                    {
-                        if( ( irqRegs & IRQ_CAD_DETECTED ) == IRQ_CAD_DETECTED )
-                        {
-                            if( cadDone != NULL )
-                            {
-                                cadDone( true );
-                            }
-                        }
-                        else
-                        {
-                            if( cadDone != NULL )
-                            {
-                                cadDone( false );
-                            }
-                        }
-                    }
-                    else if( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
-                    {
-                        if( rxTimeout != NULL )
-                        {
-                            rxTimeout( );
-                        }
-                    }
-                    break;
-                default:
-                    // Unexpected IRQ: silently returns
-                    break;
-            }
+            irqClass = IRQ_CLASS_LORA;
             break;
         case PACKET_TYPE_RANGING:
-            switch( OperatingMode )
-            {
-                // MODE_RX indicates an IRQ on the Slave side
-                case MODE_RX:
-                    if( ( irqRegs & IRQ_RANGING_SLAVE_REQUEST_DISCARDED ) == IRQ_RANGING_SLAVE_REQUEST_DISCARDED )
-                    {
-                        if( rangingDone != NULL )
-                        {
-                            rangingDone( IRQ_RANGING_SLAVE_ERROR_CODE );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RANGING_SLAVE_REQUEST_VALID ) == IRQ_RANGING_SLAVE_REQUEST_VALID )
-                    {
-                        if( rangingDone != NULL )
-                        {
-                            rangingDone( IRQ_RANGING_SLAVE_VALID_CODE );
-                        }
-                    }
-                    if( ( irqRegs & IRQ_RANGING_SLAVE_RESPONSE_DONE ) == IRQ_RANGING_SLAVE_RESPONSE_DONE )
+            irqClass = IRQ_CLASS_RANGING;
+            break;
+        default:
+            // Unexpected IRQ: silently returns
+            return;
+    }
+    switch( OperatingMode )
+    {
+        case MODE_RX:
+            irqMode = IRQ_MODE_RX;
+            break;
+        case MODE_TX:
+            irqMode = IRQ_MODE_TX;
+            break;
+        case MODE_CAD:
+            irqMode = IRQ_MODE_CAD;
+            break;
+        default:
+            // Unexpected IRQ: silently returns
+            return;
+    }
+
+    const IrqDispatchRow_t *row = &IrqDispatchTable[irqClass][irqMode];
+    uint16_t pending = irqRegs & row->Mask;
+
+    while( pending != 0 )
+    {
+        uint8_t bit = __builtin_ctz( pending );
+        pending &= pending - 1;
+
+        switch( ( IrqActions_t )row->Actions[bit] )
+        {
+            case IRQ_ACTION_TX_DONE:
+                if( txDone != NULL )
+                {
+                    txDone( );
+                }
+                break;
+            case IRQ_ACTION_TX_TIMEOUT:
+                if( txTimeout != NULL )
+                {
+                    txTimeout( );
+                }
+                break;
+            case IRQ_ACTION_RX_DONE:
+                if( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
+                {
+                    if( rxError != NULL )
                     {
-                        if( rangingDone != NULL )
-                        {
-                            rangingDone( IRQ_RANGING_SLAVE_VALID_CODE );
-                        }
+                        rxError( IRQ_CRC_ERROR_CODE );
                     }
-                    if( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+                }
+                else if( ( irqRegs & IRQ_SYNCWORD_ERROR ) == IRQ_SYNCWORD_ERROR )
+                {
+                    if( rxError != NULL )
                     {
-                        if( rangingDone != NULL )
-                        {
-                            rangingDone( IRQ_RANGING_SLAVE_ERROR_CODE );
-                        }
+                        rxError( IRQ_SYNCWORD_ERROR_CODE );
                     }
-                    if( ( irqRegs & IRQ_HEADER_VALID ) == IRQ_HEADER_VALID )
+                }
+                else
+                {
+                    if( rxDone != NULL )
                     {
-                        if( rxHeaderDone != NULL )
-                        {
-                            rxHeaderDone( );
-                        }
+                        rxDone( );
                     }
-                    if( ( irqRegs & IRQ_HEADER_ERROR ) == IRQ_HEADER_ERROR )
+                }
+                break;
+            case IRQ_ACTION_RX_DONE_LORA:
+                if( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
+                {
+                    if( rxError != NULL )
                     {
-                        if( rxError != NULL )
-                        {
-                            rxError( IRQ_HEADER_ERROR_CODE );
-                        }
+                        rxError( IRQ_CRC_ERROR_CODE );
                     }
-                    break;
-                // MODE_TX indicates an IRQ on the Master side
-                case MODE_TX:
-                    if( ( irqRegs & IRQ_RANGING_MASTER_TIMEOUT ) == IRQ_RANGING_MASTER_TIMEOUT )
+                }
+                else
+                {
+                    if( rxDone != NULL )
                     {
-                        if( rangingDone != NULL )
-                        {
-                            rangingDone( IRQ_RANGING_MASTER_ERROR_CODE );
-                        }
+                        rxDone( );
                     }
-                    if( ( irqRegs & IRQ_RANGING_MASTER_RESULT_VALID ) == IRQ_RANGING_MASTER_RESULT_VALID )
+                }
+                break;
+            case IRQ_ACTION_RX_TIMEOUT:
+                // A completed CAD takes precedence over its timeout
+                if( ( OperatingMode != MODE_CAD ) || ( ( irqRegs & IRQ_CAD_DONE ) != IRQ_CAD_DONE ) )
+                {
+                    if( rxTimeout != NULL )
                     {
-                        if( rangingDone != NULL )
-                        {
-                            rangingDone( IRQ_RANGING_MASTER_VALID_CODE );
-                        }
+                        rxTimeout( );
                     }
-                    break;
-                default:
-                    // Unexpected IRQ: silently returns
-                    break;
-            }
-            break;
-        default:
-            // Unexpected IRQ: silently returns
-            break;
+                }
+                break;
+            case IRQ_ACTION_SYNCWORD_VALID:
+                if( rxSyncWordDone != NULL )
+                {
+                    rxSyncWordDone( );
+                }
+                break;
+            case IRQ_ACTION_SYNCWORD_ERROR:
+                if( rxError != NULL )
+                {
+                    rxError( IRQ_SYNCWORD_ERROR_CODE );
+                }
+                break;
+            case IRQ_ACTION_HEADER_VALID:
+                if( rxHeaderDone != NULL )
+                {
+                    rxHeaderDone( );
+                }
+                break;
+            case IRQ_ACTION_HEADER_ERROR:
+                if( rxError != NULL )
+                {
+                    rxError( IRQ_HEADER_ERROR_CODE );
+                }
+                break;
+            case IRQ_ACTION_RANGING_ON_LORA:
+                if( rxError != NULL )
+                {
+                    rxError( IRQ_RANGING_ON_LORA_ERROR_CODE );
+                }
+                break;
+            case IRQ_ACTION_CAD_DONE:
+                if( cadDone != NULL )
+                {
+                    cadDone( ( irqRegs & IRQ_CAD_DETECTED ) == IRQ_CAD_DETECTED );
+                }
+                break;
+            case IRQ_ACTION_RANGING_SLAVE_ERROR:
+                if( rangingDone != NULL )
+                {
+                    rangingDone( IRQ_RANGING_SLAVE_ERROR_CODE );
+                }
+                break;
+            case IRQ_ACTION_RANGING_SLAVE_VALID:
+                if( rangingDone != NULL )
+                {
+                    rangingDone( IRQ_RANGING_SLAVE_VALID_CODE );
+                }
+                break;
+            case IRQ_ACTION_RANGING_MASTER_ERROR:
+                if( rangingDone != NULL )
+                {
+                    rangingDone( IRQ_RANGING_MASTER_ERROR_CODE );
+                }
+                break;
+            case IRQ_ACTION_RANGING_MASTER_VALID:
+                if( rangingDone != NULL )
+                {
+                    rangingDone( IRQ_RANGING_MASTER_VALID_CODE );
+                }
+                break;
+            default:
+                break;
+        }
     }
 }
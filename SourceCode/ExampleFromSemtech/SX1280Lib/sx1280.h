@@ -23,6 +23,13 @@ Maintainer: Miguel Luis, Gregory Cristian and Matthieu Verdy
  */
 #define SX1280_DEBUG                                0
 
+/*!
+ * \brief Converts frequencies to PLL steps with integers (1) or doubles (0)
+ */
+#ifndef SX1280_INTEGER_FREQUENCY
+#define SX1280_INTEGER_FREQUENCY                    1
+#endif
+
 /*!
  * \brief Hardware IO IRQ callback function definition
  */
@@ -43,6 +50,21 @@ typedef void ( SX1280Hal::*Trigger )( void );
 #define XTAL_FREQ                                   52000000
 #define FREQ_STEP                                   ( ( double )( XTAL_FREQ / pow( 2.0, 18.0 ) ) )
 
+/*!
+ * \brief Integer conversion from Hz to PLL steps, exact for every 32-bit
+ * frequency: steps = ( frequency * FREQ_STEP_MULTIPLIER ) >> FREQ_STEP_SHIFT,
+ * the multiplier being ceil( 2^60 / 203125 ) split in 32-bit halves
+ *
+ * \remark Only valid with the 52 MHz XTAL_FREQ, as 2^18 / 52 MHz = 2^10 / 203125
+ */
+#define FREQ_STEP_MULTIPLIER_HIGH                   1321UL
+#define FREQ_STEP_MULTIPLIER_LOW                    2269455434UL
+#define FREQ_STEP_SHIFT                             50
+
+#if SX1280_INTEGER_FREQUENCY && ( XTAL_FREQ != 52000000 )
+#error "FREQ_STEP_MULTIPLIER assumes a 52 MHz XTAL_FREQ, set SX1280_INTEGER_FREQUENCY to 0"
+#endif
+
 /*!
  * \brief Compensation delay for SetAutoTx method in microseconds
  */
@@ -901,6 +923,17 @@ typedef struct
     };
 }PacketStatus_t;
 
+/*!
+ * \brief Snapshot of a received packet returned by ReadRxFrame
+ */
+typedef struct
+{
+    uint16_t                              IrqStatus;        //!< IRQ flags at the time of the read, not cleared
+    uint8_t                               Size;             //!< Length of the payload
+    PacketStatus_t                        PacketStatus;     //!< Status of the packet
+    double                                FrequencyError;   //!< Estimated frequency error [Hz], LoRa and ranging only
+}RxFrame_t;
+
 /*!
  * \brief Represents the Rx internal counters values when GFSK or LORA packet type is used
  */
@@ -966,7 +999,8 @@ public:
     SX1280( RadioCallbacks_t *callbacks ):
         // The class members are value-initialiazed in member-initilaizer list
         Radio( callbacks ), OperatingMode( MODE_STDBY_RC ), PacketType( PACKET_TYPE_NONE ),
-        LoRaBandwidth( LORA_BW_1600 ), IrqState( false ), PollingMode( false )
+        LoRaBandwidth( LORA_BW_1600 ), LoRaHeaderType( LORA_PACKET_VARIABLE_LENGTH ), LoRaPayloadLength( 0 ),
+        IrqState( false ), PollingMode( false )
     {
         this->dioIrq        = &SX1280::OnDioIrq;
 
@@ -994,6 +1028,13 @@ private:
      */
     RadioLoRaBandwidths_t LoRaBandwidth;
 
+    /*!
+     * \brief Stores the current LORA header mode and payload length set in
+     * the radio, so that ReadRxFrame needs no register read
+     */
+    RadioLoRaPacketLengthsModes_t LoRaHeaderType;
+    uint8_t LoRaPayloadLength;
+
     /*!
      * \brief Holds a flag raised on radio interrupt
      */
@@ -1467,6 +1508,18 @@ public:
      */
     uint8_t GetPayload( uint8_t *payload, uint8_t *size, uint8_t maxSize );
 
+    /*!
+     * \brief Reads the IRQ flags, the payload, the packet status and the
+     * frequency error of the last received packet with one transaction
+     * each. If the received payload is longer than maxSize, then the method
+     * returns 1 and does not read the payload.
+     *
+     * \param [out] frame         The snapshot of the received packet
+     * \param [out] payload       A pointer to a buffer into which the payload will be copied
+     * \param [in]  maxSize       The maximal size allowed to copy into the buffer
+     */
+    uint8_t ReadRxFrame( RxFrame_t *frame, uint8_t *payload, uint8_t maxSize );
+
     /*!
      * \brief Sends a payload
      *
@@ -7,7 +7,7 @@
 #define RX_TIMEOUT_TICK_SIZE                        RADIO_TICK_SIZE_1000_US
 #define RX_TIMEOUT_VALUE                            1000 // ms
 #define TX_TIMEOUT_VALUE                            10000 // ms
-#define BUFFER_SIZE                                 255
+#define BUFFER_SIZE                                 10 // Payload length of the packet parameters
 
 const uint8_t PingMsg[] = "PING";
 const uint8_t PongMsg[] = "PONG";
@@ -55,8 +55,12 @@ PacketStatus_t packetStatus;
 ModulationParams_t modulationParams;
 
 AppStates_t AppState = APP_LOWPOWER;
+#if RADIO_PACKET_POOL_SIZE > 0
+RadioPacket_t *RxPacket = NULL;
+#else
 uint8_t Buffer[BUFFER_SIZE];
-uint8_t BufferSize = BUFFER_SIZE;
+uint8_t BufferSize = 0;
+#endif
 uint8_t counter = 0;
 
 void setup() {
@@ -65,6 +69,9 @@ void setup() {
 
   Radio.Init(&Callbacks);
   Radio.SetRegulatorMode( USE_DCDC ); // Can also be set in LDO mode but consume more power
+#if RADIO_PACKET_POOL_SIZE > 0
+  Radio.SetPacketPool( true ); // Received payloads are read straight into the driver packet pool
+#endif
   Serial.println( "\n\n\r     SX1280 Ping Pong Demo Application. \n\n\r");
 
   modulationParams.PacketType = PACKET_TYPE_LORA;
@@ -106,6 +113,9 @@ void setup() {
 }
 
 void loop() {
+  // Run the callbacks of the radio events queued by the DIO1 interrupt
+  Radio.Dispatch();
+
   if (IS_MASTER)
   {
     Radio.SendPayload( &counter, 1, ( TickTime_t ) {
@@ -125,7 +135,23 @@ void loop() {
       case APP_RX:
         AppState = APP_LOWPOWER;
 
-        Radio.GetPayload( Buffer, &BufferSize, BUFFER_SIZE );
+#if RADIO_PACKET_POOL_SIZE > 0
+        if (RxPacket != NULL)
+        {
+          Serial.print("RX ");
+          Serial.print(RxPacket->Size);
+          Serial.print(" bytes, RSSI ");
+          Serial.print(RxPacket->Rssi);
+          Serial.println(" dBm:");
+
+          for (int i = 0; i < RxPacket->Size; i++)
+          {
+            Serial.println(RxPacket->Payload[i]);
+          }
+          Radio.ReleasePacket(RxPacket);
+          RxPacket = NULL;
+        }
+#else
         if (BufferSize > 0)
         {
           Serial.print("RX ");
@@ -136,7 +162,9 @@ void loop() {
           {
             Serial.println(Buffer[i]);
           }
+          BufferSize = 0;
         }
+#endif
 
         Radio.SetRx( ( TickTime_t ) {
           RX_TIMEOUT_TICK_SIZE, RX_TIMEOUT_VALUE
@@ -176,6 +204,17 @@ void txDoneIRQ( void )
 void rxDoneIRQ( void )
 {
   AppState = APP_RX;
+#if RADIO_PACKET_POOL_SIZE > 0
+  if (RxPacket == NULL)
+  {
+    RxPacket = Radio.GetRxPacket();
+  }
+#else
+  if (Radio.GetPayload( Buffer, &BufferSize, BUFFER_SIZE ) != 0)
+  {
+    BufferSize = 0;
+  }
+#endif
 }
 
 void rxSyncWordDoneIRQ( void )
@@ -0,0 +1,629 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "RangingApp.h"
+#include "RangingCalibration.h"
+#include "FreqLUT.h"
+
+#define TX_OUTPUT_POWER                             13 // dBm
+#define RANGING_APP_BANDWIDTH                       LORA_BW_1600
+#define RANGING_APP_BANDWIDTH_KHZ                   1600
+#define RANGING_APP_SF                              LORA_SF10
+
+/*!
+   \brief Calibration of the modulation, folded at compile time, used when
+   RangingAppStart( ) gets no calibration
+*/
+#define RANGING_APP_CALIBRATION                     RangingCalibrations[RangingCalibrationRow( RANGING_APP_BANDWIDTH )][RangingCalibrationColumn( RANGING_APP_SF )]
+
+/*!
+   \brief Timeouts of the states [ms]
+
+   The exchange timeout is also given to the radio, the state timeout of
+   RANGING_APP_MASTER only covers a lost IRQ.
+*/
+#define RANGING_APP_TX_TIMEOUT                      100
+#define RANGING_APP_EXCHANGE_TIMEOUT                100
+#define RANGING_APP_SLAVE_TIMEOUT                   500
+#define RANGING_APP_PEER_TIMEOUT                    3000
+#define RANGING_APP_SWITCH_DELAY                    10
+
+/*!
+   \brief Time the master node listens for the result of the slave node [ms]
+
+   A response lost on its way to the slave node leaves the slave node one
+   exchange behind. It then waits as slave instead of sending its result,
+   and the master node gives it one more exchange after this window.
+*/
+#define RANGING_APP_RESULT_WINDOW                   100
+
+/*!
+   \brief Failed exchanges of the slave node as master before it goes back
+   to the slave role, in case both nodes ended up masters
+*/
+#define RANGING_APP_MASTER_RETRIES                  3
+
+/*!
+   \brief Failed exchanges and timeouts after which a node aborts the
+   session
+*/
+#define RANGING_APP_MAX_ERRORS                      30
+
+/*!
+   \brief Failed exchanges of the master node before its first valid one
+   after which it sends the calibration again, the slave node having likely
+   missed it, and calibrations sent before the session is aborted
+
+   These failures do not count towards RANGING_APP_MAX_ERRORS, so that a
+   lost START costs a few exchanges instead of the whole error budget.
+*/
+#define RANGING_APP_START_RETRIES                   3
+#define RANGING_APP_MAX_STARTS                      4
+
+#define RANGING_APP_NO_TIMEOUT                      0
+
+static const uint16_t RangingAppMasterIrqMask = IRQ_RANGING_MASTER_RESULT_VALID | IRQ_RANGING_MASTER_TIMEOUT;
+static const uint16_t RangingAppSlaveIrqMask = IRQ_RANGING_SLAVE_RESPONSE_DONE | IRQ_RANGING_SLAVE_REQUEST_DISCARDED;
+
+static RangingAppConfig_t AppConfig;
+static RangingAppStates_t AppState = RANGING_APP_IDLE;
+static RangingAppStates_t AppNextState = RANGING_APP_IDLE;         //!< State left to after RANGING_APP_SWITCH
+static RangingAppStats_t AppStats;
+static uint32_t AppStateEntered = 0;
+static uint32_t AppStateTimeout = RANGING_APP_NO_TIMEOUT;
+static uint32_t AppSessionStart = 0;
+static uint32_t AppTeardownStart = 0;
+static uint16_t AppCalibration = 0;
+static uint8_t AppSession = 0;
+static uint8_t AppTarget = 0;                                      //!< Valid exchanges as master needed in this session
+static uint8_t AppMeasures = 0;                                    //!< Valid exchanges as master in this session
+static uint8_t AppRetries = 0;                                     //!< Consecutive failed exchanges as master
+static uint8_t AppStarts = 0;                                      //!< Calibrations sent in this session
+static uint16_t AppErrors = 0;                                     //!< Failed exchanges and timeouts in this session
+static RadioRangingStats_t AppRangingStats;
+
+/*!
+   \brief Modem configurations, built once by RangingAppInit( ) so that
+   switching between the messages and the exchanges only sends what differs
+
+   The messages use the modulation and the channel of the exchanges: they
+   reach as far and only the packet type and parameters change.
+*/
+static RadioProfile_t MessageTxProfile;
+static RadioProfile_t MessageRxProfile;
+static RadioProfile_t RangingProfile;
+
+static void Print( const char *format, ... ) __attribute__( ( format( printf, 1, 2 ) ) );
+
+static void Print( const char *format, ... )
+{
+  char line[48];
+  va_list args;
+
+  if ( AppConfig.Print == NULL )
+  {
+    return;
+  }
+  va_start( args, format );
+  vsnprintf( line, sizeof( line ), format, args );
+  va_end( args );
+  AppConfig.Print( line );
+}
+
+/*!
+   \brief Prints a distance in centimeters as meters, without floating point
+*/
+static void PrintDistance( const char *label, int32_t distance )
+{
+  long value = labs( ( long )distance );
+
+  Print( "%s%s%ld.%02ld m", label, ( distance < 0 ) ? "-" : "", value / 100, value % 100 );
+}
+
+static void ProfilesInit( void )
+{
+  RadioProfileParams_t params;
+
+  params.ModulationParams.PacketType = PACKET_TYPE_LORA;
+  params.ModulationParams.Params.LoRa.SpreadingFactor = RANGING_APP_SF;
+  params.ModulationParams.Params.LoRa.Bandwidth = RANGING_APP_BANDWIDTH;
+  params.ModulationParams.Params.LoRa.CodingRate = LORA_CR_LI_4_5;
+
+  params.PacketParams.PacketType = PACKET_TYPE_LORA;
+  params.PacketParams.Params.LoRa.PreambleLength = 12;
+  params.PacketParams.Params.LoRa.HeaderType = LORA_PACKET_VARIABLE_LENGTH;
+  params.PacketParams.Params.LoRa.PayloadLength = RANGING_APP_MESSAGE_SIZE;
+  params.PacketParams.Params.LoRa.Crc = LORA_CRC_ON;
+  params.PacketParams.Params.LoRa.InvertIQ = LORA_IQ_NORMAL;
+
+  params.RfFrequency = Channels[0];
+  params.TxBaseAddress = 0x00;
+  params.RxBaseAddress = 0x00;
+  params.TxPower = TX_OUTPUT_POWER;
+  params.RampTime = RADIO_RAMP_20_US;
+  params.Dio2Mask = IRQ_RADIO_NONE;
+  params.Dio3Mask = IRQ_RADIO_NONE;
+
+  params.IrqMask = IRQ_TX_DONE | IRQ_RX_TX_TIMEOUT;
+  params.Dio1Mask = params.IrqMask;
+  Radio.BuildProfile( &MessageTxProfile, &params );
+
+  params.IrqMask = IRQ_RX_DONE | IRQ_RX_TX_TIMEOUT | IRQ_CRC_ERROR;
+  params.Dio1Mask = params.IrqMask;
+  Radio.BuildProfile( &MessageRxProfile, &params );
+
+  params.ModulationParams.PacketType = PACKET_TYPE_RANGING;
+  params.PacketParams.PacketType = PACKET_TYPE_RANGING;
+  params.PacketParams.Params.LoRa.PayloadLength = 7;
+  params.IrqMask = AppConfig.Master ? RangingAppMasterIrqMask : RangingAppSlaveIrqMask;
+  params.Dio1Mask = params.IrqMask;
+  Radio.BuildProfile( &RangingProfile, &params );
+}
+
+static void Enter( RangingAppStates_t state, uint32_t now, uint32_t timeout )
+{
+  AppState = state;
+  AppStateEntered = now;
+  AppStateTimeout = timeout;
+}
+
+static void MessageSend( const RangingAppMessage_t *message, RangingAppStates_t state, uint32_t now )
+{
+  uint8_t payload[RANGING_APP_MESSAGE_SIZE];
+
+  RangingAppEncode( message, payload );
+  Radio.ApplyProfile( &MessageTxProfile );
+  Radio.SendPayload( payload, RANGING_APP_MESSAGE_SIZE, ( TickTime_t ) {
+    RADIO_TICK_SIZE_1000_US, RANGING_APP_TX_TIMEOUT
+  }, 0 );
+  Enter( state, now, RANGING_APP_TX_TIMEOUT + RANGING_APP_SWITCH_DELAY );
+}
+
+/*!
+   \brief Single reception without timeout, re-armed on errors by the
+   waiting states
+*/
+static void MessageListen( void )
+{
+  Radio.ApplyProfile( &MessageRxProfile );
+  Radio.SetRx( ( TickTime_t ) {
+    RADIO_TICK_SIZE_1000_US, 0
+  } );
+}
+
+static bool MessageRead( RangingAppMessage_t *message )
+{
+  uint8_t payload[RANGING_APP_MESSAGE_SIZE];
+  uint8_t size = 0;
+
+  if ( Radio.GetPayload( payload, &size, RANGING_APP_MESSAGE_SIZE ) != 0 )
+  {
+    return false;
+  }
+  return RangingAppDecode( payload, size, message );
+}
+
+/*!
+   \brief Switches to ranging with the calibration and the frequency error
+   gradient of the modulation, the calibration being overridden when not 0
+*/
+static void RangingInit( uint16_t calibration )
+{
+  Radio.ApplyProfile( &RangingProfile );
+  Radio.SetRangingProfile( RANGING_APP_BANDWIDTH, RANGING_APP_SF );
+  AppCalibration = RANGING_APP_CALIBRATION;
+  if ( calibration != 0 )
+  {
+    Radio.SetRangingCalibration( calibration );
+    AppCalibration = calibration;
+  }
+  Print( "Calib value is : %u", AppCalibration );
+  Radio.SetRangingIdLength( RANGING_IDCHECK_LENGTH_32_BITS );
+  Radio.SetRangingRequestAddress( AppConfig.Address );
+  Radio.SetDeviceRangingAddress( AppConfig.Address );
+  Radio.RangingStatsReset( &AppRangingStats );
+  AppMeasures = 0;
+  AppRetries = 0;
+  AppErrors = 0;
+}
+
+static void MasterStart( uint32_t now )
+{
+  Radio.SetDioIrqParams( RangingAppMasterIrqMask, RangingAppMasterIrqMask, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+  Radio.SetTx( ( TickTime_t ) {
+    RADIO_TICK_SIZE_1000_US, RANGING_APP_EXCHANGE_TIMEOUT
+  } );
+  Enter( RANGING_APP_MASTER, now, 2 * RANGING_APP_EXCHANGE_TIMEOUT );
+}
+
+/*!
+   \brief Continuous reception of the ranging requests, the master node
+   takes the master role back when the slave node stays silent, the slave
+   node gives up the session
+*/
+static void SlaveStart( uint32_t now )
+{
+  Radio.SetDioIrqParams( RangingAppSlaveIrqMask, RangingAppSlaveIrqMask, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+  Radio.SetRx( ( TickTime_t ) {
+    RADIO_TICK_SIZE_1000_US, 0xFFFF
+  } );
+  Enter( RANGING_APP_SLAVE, now, AppConfig.Master ? RANGING_APP_SLAVE_TIMEOUT : RANGING_APP_PEER_TIMEOUT );
+}
+
+/*!
+   \brief Median of the exchanges of this node left by the z-score filter [cm]
+*/
+static int32_t RangingResult( void )
+{
+  RadioRangingStatsResult_t result;
+
+  Radio.RangingStatsGetResult( &AppRangingStats, AppTarget / 2, &result );
+  return ( result.Median > 0 ) ? ( result.Median * 100 ) / 256 : 0;
+}
+
+/*!
+   \brief Ends the session of the master node, with the result of the slave
+   node when it came
+*/
+static void SessionEnd( bool received, int32_t slaveResult, uint32_t now )
+{
+  int32_t result = RangingResult( );
+
+  PrintDistance( "Result is : ", result );
+  if ( received == true )
+  {
+    PrintDistance( "Slave result : ", slaveResult );
+    AppStats.Distance = ( slaveResult + result ) / 2;
+    AppStats.Teardown = now - AppTeardownStart;
+    PrintDistance( "Ranging result is : ", AppStats.Distance );
+    AppStats.Results++;
+  }
+  else
+  {
+    Print( "Session aborted" );
+  }
+  AppStats.Sessions++;
+  AppStats.Duration = now - AppSessionStart;
+  Radio.SetStandby( STDBY_RC );
+  Enter( RANGING_APP_IDLE, now, RANGING_APP_NO_TIMEOUT );
+}
+
+/*!
+   \brief Gives up the session after a silent peer, the slave node waits
+   for the next calibration
+*/
+static void SessionAbort( uint32_t now )
+{
+  if ( AppConfig.Master == true )
+  {
+    SessionEnd( false, 0, now );
+  }
+  else
+  {
+    Print( "Session aborted" );
+    MessageListen( );
+    Enter( RANGING_APP_WAIT_CALIBRATION, now, RANGING_APP_NO_TIMEOUT );
+  }
+}
+
+/*!
+   \brief Sends the calibration opening the session, the master node takes
+   the master role once it is sent
+*/
+static void StartSend( uint32_t now )
+{
+  RangingAppMessage_t message = { RANGING_APP_MESSAGE_START, AppSession, AppTarget, AppCalibration, 0 };
+
+  AppStarts++;
+  MessageSend( &message, RANGING_APP_SEND_CALIBRATION, now );
+}
+
+static void MasterError( uint32_t now )
+{
+  AppRetries++;
+  if ( ( AppConfig.Master == true ) && ( AppMeasures == 0 ) && ( AppRetries >= RANGING_APP_START_RETRIES ) )
+  {
+    if ( AppStarts >= RANGING_APP_MAX_STARTS )
+    {
+      SessionAbort( now );
+    }
+    else
+    {
+      Print( "No slave, calibration sent again" );
+      StartSend( now );
+    }
+    return;
+  }
+  AppErrors++;
+  if ( AppErrors > RANGING_APP_MAX_ERRORS )
+  {
+    SessionAbort( now );
+  }
+  else if ( ( AppConfig.Master == false ) && ( AppRetries >= RANGING_APP_MASTER_RETRIES ) )
+  {
+    AppRetries = 0;
+    SlaveStart( now );
+  }
+  else
+  {
+    MasterStart( now );
+  }
+}
+
+static void OnEvent( const RadioEvent_t *event, uint32_t now )
+{
+  RangingAppMessage_t message;
+
+  switch ( AppState )
+  {
+    case RANGING_APP_SEND_CALIBRATION:
+      if ( event->Type == RADIO_EVENT_TX_DONE )
+      {
+        AppStats.Setup = now + RANGING_APP_SWITCH_DELAY - AppSessionStart;
+        RangingInit( AppCalibration );
+        Print( "Master role" );
+        Enter( RANGING_APP_SWITCH, now, RANGING_APP_SWITCH_DELAY );
+        AppNextState = RANGING_APP_MASTER;
+      }
+      else if ( event->Type == RADIO_EVENT_TX_TIMEOUT )
+      {
+        SessionAbort( now );
+      }
+      break;
+
+    case RANGING_APP_WAIT_CALIBRATION:
+      if ( ( event->Type == RADIO_EVENT_RX_DONE ) && ( MessageRead( &message ) == true ) &&
+           ( message.Type == RANGING_APP_MESSAGE_START ) && ( message.Measures > 0 ) )
+      {
+        AppSession = message.Session;
+        AppTarget = message.Measures;
+        RangingInit( message.Calibration );
+        Print( "Slave role" );
+        SlaveStart( now );
+      }
+      else if ( ( event->Type == RADIO_EVENT_RX_DONE ) || ( event->Type == RADIO_EVENT_RX_TIMEOUT ) || ( event->Type == RADIO_EVENT_RX_ERROR ) )
+      {
+        MessageListen( );
+      }
+      break;
+
+    case RANGING_APP_MASTER:
+      if ( event->Type != RADIO_EVENT_RANGING_DONE )
+      {
+        break;
+      }
+      if ( event->RangingCode == IRQ_RANGING_MASTER_VALID_CODE )
+      {
+        RadioRangingResult_t result = Radio.GetCompensatedRangingResult( RANGING_RESULT_RAW );
+
+        Radio.RangingStatsAdd( &AppRangingStats, result.Corrected, result.Rssi );
+        AppMeasures++;
+        AppRetries = 0;
+        // The fit of RangingCalibration.h needs the register distance, before any correction
+        Print( "RNG,%u,%u,%u,%ld,%ld", RANGING_APP_BANDWIDTH_KHZ, RANGING_APP_SF >> 4, AppCalibration,
+               ( long )result.Fei, ( long )( ( result.Raw * 100 ) / 256 ) );
+
+        if ( ( AppConfig.Master == false ) && ( AppMeasures >= AppTarget ) )
+        {
+          Enter( RANGING_APP_SWITCH, now, RANGING_APP_SWITCH_DELAY );
+          AppNextState = RANGING_APP_SEND_RESULT;
+        }
+        else
+        {
+          SlaveStart( now );
+        }
+      }
+      else
+      {
+        Print( "Ranging error" );
+        MasterError( now );
+      }
+      break;
+
+    case RANGING_APP_SLAVE:
+      if ( ( event->Type != RADIO_EVENT_RANGING_DONE ) || ( event->RangingCode != IRQ_RANGING_SLAVE_VALID_CODE ) )
+      {
+        break;
+      }
+      if ( ( AppConfig.Master == true ) && ( AppMeasures >= AppTarget ) )
+      {
+        if ( AppMeasures == AppTarget )
+        {
+          AppTeardownStart = now;
+        }
+        Print( "Waiting for Slave data" );
+        MessageListen( );
+        Enter( RANGING_APP_WAIT_RESULT, now, RANGING_APP_RESULT_WINDOW );
+      }
+      else
+      {
+        Enter( RANGING_APP_SWITCH, now, RANGING_APP_SWITCH_DELAY );
+        AppNextState = RANGING_APP_MASTER;
+      }
+      break;
+
+    case RANGING_APP_SEND_RESULT:
+      if ( ( event->Type == RADIO_EVENT_TX_DONE ) || ( event->Type == RADIO_EVENT_TX_TIMEOUT ) )
+      {
+        MessageListen( );
+        Enter( RANGING_APP_WAIT_CALIBRATION, now, RANGING_APP_NO_TIMEOUT );
+      }
+      break;
+
+    case RANGING_APP_WAIT_RESULT:
+      if ( ( event->Type == RADIO_EVENT_RX_DONE ) && ( MessageRead( &message ) == true ) &&
+           ( message.Type == RANGING_APP_MESSAGE_RESULT ) && ( message.Session == AppSession ) )
+      {
+        SessionEnd( true, message.Distance, now );
+      }
+      else if ( ( event->Type == RADIO_EVENT_RX_DONE ) || ( event->Type == RADIO_EVENT_RX_TIMEOUT ) || ( event->Type == RADIO_EVENT_RX_ERROR ) )
+      {
+        MessageListen( );
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+static void OnTimeout( uint32_t now )
+{
+  if ( AppState != RANGING_APP_SWITCH )
+  {
+    AppStats.Timeouts++;
+  }
+  switch ( AppState )
+  {
+    case RANGING_APP_SWITCH:
+      if ( AppNextState == RANGING_APP_MASTER )
+      {
+        MasterStart( now );
+      }
+      else
+      {
+        RangingAppMessage_t message = { RANGING_APP_MESSAGE_RESULT, AppSession, AppMeasures, 0, RangingResult( ) };
+
+        PrintDistance( "Result is : ", message.Distance );
+        MessageSend( &message, RANGING_APP_SEND_RESULT, now );
+      }
+      break;
+
+    case RANGING_APP_MASTER:
+      MasterError( now );
+      break;
+
+    case RANGING_APP_SLAVE:
+      if ( AppConfig.Master == true )
+      {
+        AppErrors++;
+        if ( AppErrors > RANGING_APP_MAX_ERRORS )
+        {
+          SessionAbort( now );
+        }
+        else
+        {
+          MasterStart( now );
+        }
+      }
+      else
+      {
+        SessionAbort( now );
+      }
+      break;
+
+    case RANGING_APP_SEND_CALIBRATION:
+      SessionAbort( now );
+      break;
+
+    case RANGING_APP_SEND_RESULT:
+      MessageListen( );
+      Enter( RANGING_APP_WAIT_CALIBRATION, now, RANGING_APP_NO_TIMEOUT );
+      break;
+
+    case RANGING_APP_WAIT_RESULT:
+      if ( ++AppErrors > RANGING_APP_MAX_ERRORS )
+      {
+        SessionAbort( now );
+      }
+      else
+      {
+        Radio.ApplyProfile( &RangingProfile );
+        MasterStart( now );
+      }
+      break;
+
+    default:
+      AppStateTimeout = RANGING_APP_NO_TIMEOUT;
+      break;
+  }
+}
+
+void RangingAppInit( const RangingAppConfig_t *config, uint32_t now )
+{
+  AppConfig = *config;
+  memset( &AppStats, 0, sizeof( AppStats ) );
+  ProfilesInit( );
+  Radio.SetInterruptMode( );
+
+  if ( AppConfig.Master == true )
+  {
+    Enter( RANGING_APP_IDLE, now, RANGING_APP_NO_TIMEOUT );
+  }
+  else
+  {
+    MessageListen( );
+    Enter( RANGING_APP_WAIT_CALIBRATION, now, RANGING_APP_NO_TIMEOUT );
+  }
+}
+
+bool RangingAppStart( uint16_t calibration, uint32_t now )
+{
+  if ( ( AppConfig.Master == false ) || ( AppState != RANGING_APP_IDLE ) )
+  {
+    return false;
+  }
+  AppSession++;
+  AppCalibration = calibration;
+  AppTarget = AppConfig.Measures;
+  AppSessionStart = now;
+  AppStarts = 0;
+  StartSend( now );
+  return true;
+}
+
+void RangingAppEncode( const RangingAppMessage_t *message, uint8_t *buffer )
+{
+  uint32_t distance = ( uint32_t )message->Distance;
+
+  buffer[0] = message->Type;
+  buffer[1] = message->Session;
+  buffer[2] = message->Measures;
+  buffer[3] = ( uint8_t )message->Calibration;
+  buffer[4] = ( uint8_t )( message->Calibration >> 8 );
+  buffer[5] = ( uint8_t )distance;
+  buffer[6] = ( uint8_t )( distance >> 8 );
+  buffer[7] = ( uint8_t )( distance >> 16 );
+  buffer[8] = ( uint8_t )( distance >> 24 );
+}
+
+bool RangingAppDecode( const uint8_t *buffer, uint8_t size, RangingAppMessage_t *message )
+{
+  if ( ( size != RANGING_APP_MESSAGE_SIZE ) ||
+       ( ( buffer[0] != RANGING_APP_MESSAGE_START ) && ( buffer[0] != RANGING_APP_MESSAGE_RESULT ) ) )
+  {
+    return false;
+  }
+  message->Type = buffer[0];
+  message->Session = buffer[1];
+  message->Measures = buffer[2];
+  message->Calibration = ( uint16_t )( buffer[3] | ( buffer[4] << 8 ) );
+  message->Distance = ( int32_t )( ( uint32_t )buffer[5] | ( ( uint32_t )buffer[6] << 8 ) | ( ( uint32_t )buffer[7] << 16 ) |
+                                   ( ( uint32_t )buffer[8] << 24 ) );
+  return true;
+}
+
+void RangingAppRun( uint32_t now )
+{
+  RadioEvent_t event;
+
+  while ( Radio.Poll( &event ) == true )
+  {
+    OnEvent( &event, now );
+  }
+  if ( ( AppStateTimeout != RANGING_APP_NO_TIMEOUT ) && ( ( uint32_t )( now - AppStateEntered ) >= AppStateTimeout ) )
+  {
+    OnTimeout( now );
+  }
+}
+
+RangingAppStates_t RangingAppGetState( void )
+{
+  return AppState;
+}
+
+RangingAppStats_t RangingAppGetStats( void )
+{
+  return AppStats;
+}
@@ -0,0 +1,126 @@
+#ifndef __RANGING_APP_H__
+#define __RANGING_APP_H__
+
+#include "Radio.h"
+
+/*!
+   \brief States of the ranging application
+*/
+typedef enum
+{
+  RANGING_APP_IDLE                        = 0x00,         //!< Master waiting for RangingAppStart( )
+  RANGING_APP_SEND_CALIBRATION,                           //!< Master sending the calibration over LoRa
+  RANGING_APP_WAIT_CALIBRATION,                           //!< Slave waiting for the calibration over LoRa
+  RANGING_APP_MASTER,                                     //!< Ranging exchange as master in progress
+  RANGING_APP_SLAVE,                                      //!< Waiting for the ranging request of the peer
+  RANGING_APP_SWITCH,                                     //!< Pause giving the peer the time to become slave
+  RANGING_APP_SEND_RESULT,                                //!< Slave sending its result over LoRa
+  RANGING_APP_WAIT_RESULT,                                //!< Master waiting for the result of the slave
+} RangingAppStates_t;
+
+/*!
+   \brief Size of the session messages on air [bytes]
+*/
+#define RANGING_APP_MESSAGE_SIZE                    9
+
+/*!
+   \brief Kinds of session messages
+*/
+typedef enum
+{
+  RANGING_APP_MESSAGE_START               = 0x01,         //!< Master node to slave node, opens a session
+  RANGING_APP_MESSAGE_RESULT              = 0x02,         //!< Slave node to master node, closes a session
+} RangingAppMessageTypes_t;
+
+/*!
+   \brief Session message, sent at the start and at the end of a session
+   with the modulation of the exchanges. The master node sends START again
+   when its first exchanges fail
+
+   On air the fields follow each other in this order, little endian, with
+   no padding.
+*/
+typedef struct
+{
+  uint8_t Type;                                           //!< One of RangingAppMessageTypes_t
+  uint8_t Session;                                        //!< Session number, echoed by the slave node
+  uint8_t Measures;                                       //!< START: exchanges per node, RESULT: exchanges done
+  uint16_t Calibration;                                   //!< START: ranging calibration, 0 for RangingCalibration.h, RESULT: 0
+  int32_t Distance;                                       //!< START: 0, RESULT: median of the slave node [cm]
+} RangingAppMessage_t;
+
+/*!
+   \brief Configuration of the ranging application
+*/
+typedef struct
+{
+  bool Master;                                            //!< Starts the sessions and prints the distance
+  uint32_t Address;                                       //!< Ranging address of the pair
+  uint8_t Measures;                                       //!< Valid exchanges of each node in a session, given by the master node
+  void ( *Print )( const char *line );                    //!< Output of the progress lines, may be NULL
+} RangingAppConfig_t;
+
+/*!
+   \brief Outcome of a session, on the master
+*/
+typedef struct
+{
+  uint32_t Sessions;                                      //!< Sessions ended, with or without result
+  uint32_t Results;                                       //!< Sessions ended with a distance
+  uint32_t Timeouts;                                      //!< States left on their timeout
+  int32_t Distance;                                       //!< Last distance [cm]
+  uint32_t Duration;                                      //!< Duration of the last session [ms]
+  uint32_t Setup;                                         //!< From RangingAppStart( ) to the first exchange of the last session [ms]
+  uint32_t Teardown;                                      //!< From the last exchange needed to the result of the slave node [ms]
+} RangingAppStats_t;
+
+/*!
+   \brief Configures the radio and enters RANGING_APP_IDLE on the master,
+   RANGING_APP_WAIT_CALIBRATION on the slave
+
+   \param [in]  config        Configuration, copied
+   \param [in]  now           Current time [ms]
+*/
+void RangingAppInit( const RangingAppConfig_t *config, uint32_t now );
+
+/*!
+   \brief Starts a session on the master node
+
+   Each valid exchange prints a line RNG,<bandwidth kHz>,<SF>,<calibration>,
+   <frequency error Hz>,<distance cm>, the log RangingCalibFit fits the
+   tables of RangingCalibration.h from. The distance of the line is before
+   the frequency error compensation, the sessions use the compensated one.
+
+   \param [in]  calibration   Ranging calibration of both nodes, 0 for the
+                              value of RangingCalibration.h
+   \retval      started       false when a session is already running
+*/
+bool RangingAppStart( uint16_t calibration, uint32_t now );
+
+/*!
+   \brief Handles the pending radio events and the expired state timeout,
+   never waits. To be called from the main loop as often as possible
+
+   \param [in]  now           Current time [ms]
+*/
+void RangingAppRun( uint32_t now );
+
+/*!
+   \brief Writes a session message as sent on air
+
+   \param [in]  message       Message to encode
+   \param [out] buffer        RANGING_APP_MESSAGE_SIZE bytes
+*/
+void RangingAppEncode( const RangingAppMessage_t *message, uint8_t *buffer );
+
+/*!
+   \brief Reads a session message received from the air
+
+   \retval      valid         false when the size or the type is unknown
+*/
+bool RangingAppDecode( const uint8_t *buffer, uint8_t size, RangingAppMessage_t *message );
+
+RangingAppStates_t RangingAppGetState( void );
+RangingAppStats_t RangingAppGetStats( void );
+
+#endif /* __RANGING_APP_H__ */
@@ -0,0 +1,139 @@
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+// Features compiled into the driver, override with -DRADIO_FEATURE_xxx=0 or
+// edit the default here. LoRa is always available; GFSK, FLRC and BLE share
+// the sync word, CRC and whitening methods, which go away with the last of
+// them. Debug tracing prints the ranging computation steps (Serial on
+// Arduino, stdout elsewhere). Profiles apply a precomputed modem
+// configuration at once, see Radio.ApplyProfile( )
+#ifndef RADIO_FEATURE_RANGING
+#define RADIO_FEATURE_RANGING 1
+#endif
+#ifndef RADIO_FEATURE_BLE
+#define RADIO_FEATURE_BLE 1
+#endif
+#ifndef RADIO_FEATURE_FLRC
+#define RADIO_FEATURE_FLRC 1
+#endif
+#ifndef RADIO_FEATURE_GFSK
+#define RADIO_FEATURE_GFSK 1
+#endif
+#ifndef RADIO_FEATURE_DEBUG
+#define RADIO_FEATURE_DEBUG 0
+#endif
+#ifndef RADIO_FEATURE_PROFILES
+#define RADIO_FEATURE_PROFILES 1
+#endif
+
+// Short range correction of the ranging result from the instantaneous RSSI,
+// applied below 50 m
+#ifndef RADIO_RANGING_SHORT_RANGE_CORRECTION
+#define RADIO_RANGING_SHORT_RANGE_CORRECTION 1
+#endif
+
+// Conversion from Hz to PLL steps in SetRfFrequency, profiles and the hop
+// engine: exact 64-bit integer multiply-shift (1) or double division (0)
+#ifndef RADIO_INTEGER_FREQUENCY
+#define RADIO_INTEGER_FREQUENCY 1
+#endif
+
+#define RADIO_FEATURE_SYNC_WORD ( RADIO_FEATURE_GFSK || RADIO_FEATURE_FLRC || RADIO_FEATURE_BLE )
+
+#define NSS 10
+#define NRESET 6
+#define BUSY 5
+#define DIO1 2
+#define DIO2 3
+#define DIO3 4
+
+// Linux transport: spidev device and gpiochip line offsets (set NSS to -1 to
+// let the kernel drive the hardware chip select)
+#define LINUX_SPI_DEVICE "/dev/spidev0.0"
+#define LINUX_SPI_SPEED 8000000
+#define LINUX_GPIO_CHIP "gpiochip0"
+#define LINUX_GPIO_NSS 8
+#define LINUX_GPIO_NRESET 25
+#define LINUX_GPIO_BUSY 24
+#define LINUX_GPIO_DIO1 23
+
+// BUSY line wait: polls without pause, polls with yield, pause between the
+// remaining polls [us] and timeout [us]
+#define BUSY_WAIT_SPIN_COUNT 100
+#define BUSY_WAIT_YIELD_COUNT 100
+#define BUSY_WAIT_SLEEP_TIME 50
+#define BUSY_WAIT_TIMEOUT 100000
+
+// Uncomment to record a histogram of the BUSY wait time of every opcode
+// (about 1.2 kB of RAM), see Radio.DumpBusyHistogram( )
+// #define BUSY_WAIT_HISTOGRAM
+
+// SPI frame holding the current command: opcode, up to 3 header bytes and
+// the payload. The default of 259 sends a 255 bytes payload in one frame, a
+// smaller one (16 at least) splits longer buffer and register accesses
+#ifndef RADIO_SPI_FRAME_SIZE
+#define RADIO_SPI_FRAME_SIZE 259
+#endif
+
+// Queue of the DIO1 edges and queue of the decoded events (powers of 2, 4
+// and 14 bytes of RAM per entry on AVR), see Radio.Dispatch( )
+#ifndef RADIO_IRQ_QUEUE_SIZE
+#define RADIO_IRQ_QUEUE_SIZE 4
+#endif
+#ifndef RADIO_EVENT_QUEUE_SIZE
+#define RADIO_EVENT_QUEUE_SIZE 4
+#endif
+
+// The pool, TX queue, hop, anchor and result buffers below are opt-in: they
+// default to 0, which removes the feature and its RAM so that the default
+// build fits parts with 2 kB of RAM. Size them here or on the compiler
+// command line to use the feature
+
+// RX packet pool: number of slots (at most 16, 0 removes the pool) and
+// payload size of a slot, see Radio.SetPacketPool( )
+#ifndef RADIO_PACKET_POOL_SIZE
+#define RADIO_PACKET_POOL_SIZE 0
+#endif
+#ifndef RADIO_PACKET_PAYLOAD_SIZE
+#define RADIO_PACKET_PAYLOAD_SIZE 255
+#endif
+
+// TX queue: number of frames waiting for transmission (power of 2, 0
+// removes the queue), see Radio.EnqueuePayload( )
+#ifndef RADIO_TX_QUEUE_SIZE
+#define RADIO_TX_QUEUE_SIZE 0
+#endif
+
+// Frequency hopping: number of channels whose PLL steps are precomputed (3
+// bytes of RAM each, 0 removes the hop engine), see Radio.SetHopChannels( )
+#ifndef RADIO_HOP_CHANNELS
+#define RADIO_HOP_CHANNELS 0
+#endif
+
+// Ranging statistics: samples held by a RadioRangingStats_t (at most 255, 5
+// bytes of RAM each, 0 removes the statistics) and range of the z-score
+// widened until enough samples are accepted, see Radio.RangingStatsAdd( )
+#ifndef RADIO_RANGING_STATS_SIZE
+#define RADIO_RANGING_STATS_SIZE 64
+#endif
+#ifndef RADIO_RANGING_ZSCORE_MIN
+#define RADIO_RANGING_ZSCORE_MIN 1
+#endif
+#ifndef RADIO_RANGING_ZSCORE_MAX
+#define RADIO_RANGING_ZSCORE_MAX 5
+#endif
+
+// Ranging scheduler: number of anchors ranged in turn, one per TDMA slot
+// (about 28 bytes of RAM each, 0 removes the scheduler), see
+// Radio.SetRangingAnchors( )
+#ifndef RADIO_RANGING_ANCHORS
+#define RADIO_RANGING_ANCHORS 0
+#endif
+
+// Continuous ranging: results waiting to be read (power of 2, 12 bytes of
+// RAM each, 0 removes the continuous mode), see Radio.StartContinuousRanging( )
+#ifndef RADIO_RANGING_RESULTS
+#define RADIO_RANGING_RESULTS 0
+#endif
+
+#endif /* CONFIG_H__ */
@@ -13,6 +13,17 @@
 #define XTAL_FREQ                                   52000000
 #define FREQ_STEP                                   ( ( double )( XTAL_FREQ / pow( 2.0, 18.0 ) ) )
 
+/*!
+   \brief Integer conversion from Hz to PLL steps, exact for every 32-bit
+   frequency: steps = ( frequency * FREQ_STEP_MULTIPLIER ) >> FREQ_STEP_SHIFT,
+   the multiplier being ceil( 2^60 / 203125 ) split in 32-bit halves
+
+   \remark Only valid with the 52 MHz XTAL_FREQ, as 2^18 / 52 MHz = 2^10 / 203125
+*/
+#define FREQ_STEP_MULTIPLIER_HIGH                   1321UL
+#define FREQ_STEP_MULTIPLIER_LOW                    2269455434UL
+#define FREQ_STEP_SHIFT                             50
+
 /*!
    \brief Compensation delay for SetAutoTx method in microseconds
 */
@@ -229,6 +240,54 @@ typedef struct
   void ( *cadDone )( bool cadFlag );              //!< Pointer to a function run on channel activity detected
 } RadioCallbacks_t;
 
+/*!
+   \brief Represents the events returned by Poll( ), one per callback type
+*/
+typedef enum
+{
+  RADIO_EVENT_NONE                        = 0x00,
+  RADIO_EVENT_TX_DONE,
+  RADIO_EVENT_RX_DONE,
+  RADIO_EVENT_RX_SYNCWORD_DONE,
+  RADIO_EVENT_RX_HEADER_DONE,
+  RADIO_EVENT_TX_TIMEOUT,
+  RADIO_EVENT_RX_TIMEOUT,
+  RADIO_EVENT_RX_ERROR,
+  RADIO_EVENT_RANGING_DONE,
+  RADIO_EVENT_CAD_DONE,
+} RadioEventTypes_t;
+
+/*!
+   \brief A received packet held in a slot of the packet pool
+*/
+typedef struct
+{
+  uint8_t Payload[RADIO_PACKET_PAYLOAD_SIZE];     //!< The received payload
+  uint8_t Size;                                   //!< Length of the payload
+  int8_t Rssi;                                    //!< RSSI of the packet [dBm]
+  int8_t Snr;                                     //!< SNR of the packet [dB], 0 outside LoRa and ranging
+  uint32_t Timestamp;                             //!< Time of the DIO1 edge in microseconds
+} RadioPacket_t;
+
+/*!
+   \brief A radio event decoded from the IRQ status in the main loop
+*/
+typedef struct
+{
+  RadioEventTypes_t Type;                         //!< The kind of event
+  uint32_t Timestamp;                             //!< Time of the DIO1 edge in microseconds
+  uint16_t IrqStatus;                             //!< IRQ status register the event was decoded from
+  union
+  {
+    uint8_t RxLength;                             //!< Payload length, for RADIO_EVENT_RX_DONE
+    IrqErrorCode_t ErrorCode;                     //!< Error code, for RADIO_EVENT_RX_ERROR
+    IrqRangingCode_t RangingCode;                 //!< Ranging code, for RADIO_EVENT_RANGING_DONE
+    bool CadDetected;                             //!< Channel activity flag, for RADIO_EVENT_CAD_DONE
+    uint32_t TxQueueLatency;                      //!< Time from EnqueuePayload( ) to SetTx [us], for RADIO_EVENT_TX_DONE and RADIO_EVENT_TX_TIMEOUT of a queued frame
+  };
+  RadioPacket_t *Packet;                          //!< Pooled copy of the payload for RADIO_EVENT_RX_DONE, NULL when the pool is disabled or empty
+} RadioEvent_t;
+
 /*!
    \brief Represents the states of the radio
 */
@@ -941,6 +1000,17 @@ typedef struct
   };
 } PacketStatus_t;
 
+/*!
+   \brief Snapshot of a received packet returned by ReadRxFrame( )
+*/
+typedef struct
+{
+  uint16_t IrqStatus;                             //!< IRQ flags at the time of the read, not cleared
+  uint8_t Size;                                   //!< Length of the payload
+  PacketStatus_t PacketStatus;                    //!< Status of the packet
+  double FrequencyError;                          //!< Estimated frequency error [Hz], LoRa and ranging only
+} RadioRxFrame_t;
+
 /*!
    \brief Represents the Rx internal counters values when GFSK or LORA packet type is used
 */
@@ -989,4 +1059,222 @@ typedef struct
   uint8_t DataRamRetention        : 1;                    //!< Data ram is conserved during sleep
 } SleepParams_t;
 
+/*!
+   \brief Counters of the register shadow cache, one count per register read call
+*/
+typedef struct
+{
+  uint32_t Hits;                                          //!< Reads served from the cache without SPI transaction
+  uint32_t Misses;                                        //!< Reads of cacheable registers that needed a SPI transaction
+  uint32_t Uncached;                                      //!< Reads of registers the radio may update on its own
+} RadioRegCacheStats_t;
+
+/*!
+   \brief Counters of the TX queue, the latency runs from EnqueuePayload( )
+   to the SetTx of the frame
+*/
+typedef struct
+{
+  uint32_t Frames;                                        //!< Frames sent or timed out
+  uint32_t TotalLatency;                                  //!< Sum of the frame latencies [us]
+  uint32_t MaxLatency;                                    //!< Longest frame latency [us]
+  uint32_t Preloaded;                                     //!< Frames started from the double buffer
+} RadioTxQueueStats_t;
+
+/*!
+   \brief Events on which the hop engine moves to the next channel by itself
+*/
+typedef enum
+{
+  RADIO_HOP_MANUAL                        = 0x00,         //!< Only on Hop( )
+  RADIO_HOP_ON_TX_DONE                    = 0x01,
+  RADIO_HOP_ON_RANGING_DONE               = 0x02,         //!< Valid or failed exchange, master or slave
+} RadioHopTriggers_t;
+
+/*!
+   \brief Counters of the hop engine, the latency runs from Hop( ) or the
+   triggering interrupt to the end of the SetRfFrequency transaction
+*/
+typedef struct
+{
+  uint32_t Hops;                                          //!< Channel changes
+  uint32_t TotalLatency;                                  //!< Sum of the hop latencies [us]
+  uint32_t MaxLatency;                                    //!< Longest hop latency [us]
+} RadioHopStats_t;
+
+/*!
+   \brief Modem configuration applied at once by ApplyProfile( ), with the
+   arguments of the matching Set functions
+*/
+typedef struct
+{
+  ModulationParams_t ModulationParams;                    //!< Packet type and modulation parameters
+  PacketParams_t PacketParams;                            //!< Packet parameters, same packet type
+  uint32_t RfFrequency;                                   //!< RF frequency [Hz]
+  uint8_t TxBaseAddress;                                  //!< TX base address of the data buffer
+  uint8_t RxBaseAddress;                                  //!< RX base address of the data buffer
+  int8_t TxPower;                                         //!< Output power [dBm]
+  RadioRampTimes_t RampTime;                              //!< Power amplifier ramp time
+  uint16_t IrqMask;                                       //!< Enabled interrupts
+  uint16_t Dio1Mask;                                      //!< Interrupts routed to DIO1
+  uint16_t Dio2Mask;                                      //!< Interrupts routed to DIO2
+  uint16_t Dio3Mask;                                      //!< Interrupts routed to DIO3
+} RadioProfileParams_t;
+
+/*!
+   \brief Number of commands of a profile and size of their frames: packet
+   type, modulation parameters, packet parameters, RF frequency, buffer base
+   addresses, TX parameters and DIO IRQ parameters, each with its opcode
+*/
+#define RADIO_PROFILE_COMMANDS                      7
+#define RADIO_PROFILE_SIZE                          33
+
+/*!
+   \brief Profile built once by BuildProfile( ), holds the ready to send
+   command frames
+*/
+typedef struct
+{
+  RadioProfileParams_t Params;                            //!< Configuration the frames were built from
+  uint8_t Commands[RADIO_PROFILE_SIZE];                   //!< Opcode and parameters of each command
+} RadioProfile_t;
+
+#if RADIO_FEATURE_RANGING
+/*!
+   \brief Ranging result read with the frequency error and the RSSI of the
+   same exchange by GetCompensatedRangingResult( )
+*/
+typedef struct
+{
+  int32_t Raw;                                            //!< Register distance in Q24.8 meters, before any correction
+  int32_t Corrected;                                      //!< Raw with the frequency error gradient of the profile, then the short range correction if enabled
+  int32_t Fei;                                            //!< Frequency error read by the master [Hz], opposite to the one the slave measures
+  int8_t Rssi;                                            //!< RSSI read after the exchange [dBm]
+} RadioRangingResult_t;
+#endif
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_STATS_SIZE > 0 )
+/*!
+   \brief Ranging samples aggregated as they arrive by RangingStatsAdd( ).
+   The samples are kept sorted with their RSSI weight, the mean and variance
+   are updated with Welford's method
+*/
+typedef struct
+{
+  int32_t Samples[RADIO_RANGING_STATS_SIZE];              //!< Distances in Q24.8 meters, in ascending order
+  uint8_t Weights[RADIO_RANGING_STATS_SIZE];              //!< RSSI weight of each sample
+  uint8_t Count;                                          //!< Number of samples
+  int32_t RssiSum;                                        //!< Sum of the RSSI [dBm]
+  int64_t Mean;                                           //!< Mean in Q16 meters (1/65536 m)
+  int64_t M2;                                             //!< Sum of the squared deviations in Q16 square meters
+} RadioRangingStats_t;
+
+/*!
+   \brief Aggregated ranging result. The accepted samples are those within
+   ZScore standard deviations of the mean
+*/
+typedef struct
+{
+  uint8_t Count;                                          //!< Samples added
+  uint8_t Accepted;                                       //!< Samples inside the z-score window
+  uint8_t ZScore;                                         //!< z-score limit of the window
+  int32_t Median;                                         //!< Median of the accepted samples, Q24.8 meters
+  int32_t WeightedMean;                                   //!< RSSI weighted mean of the accepted samples, Q24.8 meters
+  int32_t Mean;                                           //!< Mean of all the samples, Q24.8 meters
+  int32_t StdDev;                                         //!< Standard deviation of all the samples, Q24.8 meters
+  int8_t Rssi;                                            //!< Mean RSSI [dBm], for the short range correction
+} RadioRangingStatsResult_t;
+#endif
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+/*!
+   \brief Outcome of the exchange with one anchor in a ranging round
+*/
+typedef struct
+{
+  uint32_t Address;                                       //!< Ranging address of the anchor
+  int32_t Distance;                                       //!< Distance compensated for the frequency error in Q24.8 meters, 0 when not valid
+  int8_t Rssi;                                            //!< RSSI read after the exchange [dBm]
+  bool Valid;                                             //!< The exchange completed
+} RadioAnchorRange_t;
+
+/*!
+   \brief A round of the ranging scheduler, one exchange with every anchor
+   in the order given to SetRangingAnchors( )
+*/
+typedef struct
+{
+  uint32_t Round;                                         //!< Number of the round since StartRangingScheduler( )
+  uint32_t Timestamp;                                     //!< Start of the first slot of the round [us]
+  uint32_t Duration;                                      //!< From the start of the first slot to the end of the last exchange [us]
+  uint8_t Count;                                          //!< Number of anchors
+  uint8_t Valid;                                          //!< Number of valid exchanges
+  RadioAnchorRange_t Ranges[RADIO_RANGING_ANCHORS];       //!< Result of each anchor
+} RadioRangingRound_t;
+
+/*!
+   \brief Counters of the ranging scheduler, the slot latency runs from the
+   SetTx of a slot to the end of the reading of its result
+*/
+typedef struct
+{
+  uint32_t Rounds;                                        //!< Completed rounds
+  uint32_t Slots;                                         //!< Completed exchanges, valid or not
+  uint32_t Failed;                                        //!< Exchanges ended by a ranging timeout
+  uint32_t Overruns;                                      //!< Slots started a whole slot late
+  uint32_t Dropped;                                       //!< Rounds overwritten before GetRangingRound( )
+  uint32_t TotalLatency;                                  //!< Sum of the slot latencies [us]
+  uint32_t MaxLatency;                                    //!< Longest slot latency [us]
+} RadioRangingSchedulerStats_t;
+#endif
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+/*!
+   \brief A result of the continuous ranging mode
+*/
+typedef struct
+{
+  uint32_t Timestamp;                                     //!< Time of the DIO1 edge ending the exchange [us]
+  int32_t Distance;                                       //!< Distance compensated for the frequency error in Q24.8 meters
+  int8_t Rssi;                                            //!< RSSI read after the exchange [dBm]
+} RadioRangingSample_t;
+
+/*!
+   \brief Counters of the continuous ranging mode, the re-arm latency runs
+   from the DIO1 edge ending an exchange to the SetTx of the next one
+*/
+typedef struct
+{
+  uint32_t Measures;                                      //!< Valid exchanges
+  uint32_t Failed;                                        //!< Exchanges ended by a ranging timeout
+  uint32_t Overflows;                                     //!< Results lost on a full result queue
+  uint32_t TotalRearm;                                    //!< Sum of the re-arm latencies [us]
+  uint32_t MaxRearm;                                      //!< Longest re-arm latency [us]
+} RadioContinuousRangingStats_t;
+#endif
+
+/*!
+   \brief Errors reported by the driver through Radio.GetLastError( )
+*/
+typedef enum
+{
+  RADIO_ERROR_NONE                        = 0x00,
+  RADIO_ERROR_BUSY_TIMEOUT,                               //!< BUSY stayed high longer than the wait timeout
+} RadioErrors_t;
+
+/*!
+   \brief Strategy used while waiting for the BUSY line to go low
+
+   The line is first polled SpinCount times back to back, then YieldCount
+   times letting other tasks run in between, then every SleepTime until it
+   is released or Timeout is reached.
+*/
+typedef struct
+{
+  uint16_t SpinCount;                                     //!< Number of polls without pause
+  uint16_t YieldCount;                                    //!< Number of polls separated by a transport yield
+  uint32_t SleepTime;                                     //!< Pause between the remaining polls [us]
+  uint32_t Timeout;                                       //!< Longest wait before giving up [us], 0 waits forever
+} RadioBusyWaitParams_t;
+
 #endif /* __HEADER_H__ */
@@ -0,0 +1,302 @@
+#ifndef __RADIO_H__
+#define __RADIO_H__
+
+#include "Radio_Methods.h"
+
+typedef struct {
+  bool (*Init)(RadioCallbacks_t* callbacks);
+  void (*SetPollingMode)(void);
+  void (*SetInterruptMode)(void);
+  void (*SetRegistersDefault)(void);
+  uint16_t (*GetFirmwareVersion)(void);
+  void (*Reset)(void);
+  void (*Wakeup)(void);
+  void (*WriteCommand)(RadioCommands_t opcode, uint8_t *buffer, uint16_t size);
+  void (*ReadCommand)(RadioCommands_t opcode, uint8_t *buffer, uint16_t size);
+  void (*WriteRegister)(uint16_t address, uint8_t *buffer, uint16_t size);
+  //  void (*WriteRegister)(uint16_t address, uint8_t value);
+  void (*ReadRegister)(uint16_t address, uint8_t *buffer, uint16_t size);
+  //  uint8_t (*ReadRegister)(uint16_t address);
+  void (*WriteBuffer)(uint8_t offset, uint8_t *buffer, uint8_t size);
+  void (*ReadBuffer)(uint8_t offset, uint8_t *buffer, uint8_t size);
+  uint8_t (*GetDioStatus)(void);
+  RadioOperatingModes_t (*GetOpMode)(void);
+  RadioStatus_t (*GetStatus)(void);
+  void (*SetSleep)(SleepParams_t sleepConfig);
+  void (*SetStandby)(RadioStandbyModes_t mode);
+  void (*SetFs)(void);
+  void (*SetTx)(TickTime_t timeout);
+  void (*SetRx)(TickTime_t timeout);
+  void (*SetRxDutyCycle)(RadioTickSizes_t periodBase, uint16_t periodBaseCountRx, uint16_t periodBaseCountSleep);
+  void (*SetCad)(void);
+  void (*SetTxContinuousWave)(void);
+  void (*SetTxContinuousPreamble)(void);
+  void (*SetPacketType)(RadioPacketTypes_t packetType);
+  RadioPacketTypes_t (*GetPacketType)(bool returnLocalCopy);
+  void (*SetRfFrequency)(uint32_t rfFrequency);
+  void (*SetTxParams)(int8_t power, RadioRampTimes_t rampTime);
+  void (*SetCadParams)(RadioLoRaCadSymbols_t cadSymbolNum);
+  void (*SetBufferBaseAddresses)(uint8_t txBaseAddress, uint8_t rxBaseAddress);
+  void (*SetModulationParams)(ModulationParams_t *modParams);
+  void (*SetPacketParams)(PacketParams_t *packetParams);
+  void (*GetRxBufferStatus)(uint8_t *rxPayloadLength, uint8_t *rxStartBufferPointer);
+  void (*GetPacketStatus)(PacketStatus_t *packetStatus);
+  int8_t (*GetRssiInst)(void);
+  void (*SetDioIrqParams)(uint16_t irqMask, uint16_t dio1Mask, uint16_t dio2Mask, uint16_t dio3Mask);
+  uint16_t (*GetIrqStatus)(void);
+  void (*ClearIrqStatus)(uint16_t irqMask);
+  void (*Calibrate)(CalibrationParams_t calibParam);
+  void (*SetRegulatorMode)(RadioRegulatorModes_t mode);
+  void (*SetSaveContext)(void);
+  void (*SetAutoTx)(uint16_t time);
+  void (*SetAutoFs)(bool enableAutoFs);
+  void (*SetLongPreamble)(bool enable);
+  void (*SetPayload)(uint8_t *payload, uint8_t size, uint8_t offsetx00);
+  uint8_t (*GetPayload)(uint8_t *payload, uint8_t *size, uint8_t maxSize);
+  void (*SendPayload)(uint8_t *payload, uint8_t size, TickTime_t timeout, uint8_t offset);
+#if RADIO_FEATURE_SYNC_WORD
+  uint8_t (*SetSyncWord)(uint8_t syncWordIdx, uint8_t *syncWord);
+  void (*SetSyncWordErrorTolerance)(uint8_t errorBits);
+  uint8_t (*SetCrcSeed)(uint8_t *seed);
+#endif
+#if RADIO_FEATURE_BLE
+  void (*SetBleAccessAddress)(uint32_t accessAddress);
+  void (*SetBleAdvertizerAccessAddress)(void);
+#endif
+#if RADIO_FEATURE_SYNC_WORD
+  void (*SetCrcPolynomial)(uint16_t polynomial);
+  void (*SetWhiteningSeed)(uint8_t seed);
+#endif
+#if RADIO_FEATURE_RANGING
+  void (*SetRangingIdLength)(RadioRangingIdCheckLengths_t length);
+  void (*SetDeviceRangingAddress)(uint32_t address);
+  void (*SetRangingRequestAddress)(uint32_t address);
+  double (*GetRangingResult)(RadioRangingResultTypes_t resultType);
+  void (*SetRangingCalibration)(uint16_t cal);
+  void (*RangingClearFilterResult)(void);
+  void (*RangingSetFilterNumSamples)(uint8_t numSample);
+#endif
+  double (*GetFrequencyError)();
+  void (*ProcessIrqs)(void);
+  void (*ForcePreambleLength)(RadioPreambleLengths_t preambleLength);
+  uint32_t (*GetSpiTransactionCount)(void);
+  void (*ResetSpiTransactionCount)(void);
+  void (*SetTransport)(const RadioTransport_t *transport);
+  bool (*WaitForIrq)(uint32_t timeout);
+  void (*SetRegisterCache)(bool enable);
+  RadioRegCacheStats_t (*GetRegisterCacheStats)(void);
+  void (*ResetRegisterCacheStats)(void);
+  uint32_t (*ReadRegisterRange)(uint16_t address, uint8_t size);
+  bool (*Poll)(RadioEvent_t *event);
+  void (*Dispatch)(void);
+  uint16_t (*GetDroppedEvents)(void);
+  void (*SetBusyWaitParams)(RadioBusyWaitParams_t *params);
+  RadioErrors_t (*GetLastError)(void);
+  void (*DumpBusyHistogram)(void (*print)(const char *line));
+  void (*ResetBusyHistogram)(void);
+  void (*SetLazyBusy)(bool enable);
+#if RADIO_PACKET_POOL_SIZE > 0
+  void (*SetPacketPool)(bool enable);
+  RadioPacket_t *(*GetRxPacket)(void);
+  void (*ReleasePacket)(RadioPacket_t *packet);
+  uint8_t (*GetFreePackets)(void);
+#endif
+  uint8_t (*ReadRxFrame)(RadioRxFrame_t *frame, uint8_t *payload, uint8_t maxSize);
+#if RADIO_TX_QUEUE_SIZE > 0
+  bool (*EnqueuePayload)(uint8_t *payload, uint8_t size, TickTime_t timeout);
+  uint8_t (*GetTxQueueCount)(void);
+  RadioTxQueueStats_t (*GetTxQueueStats)(void);
+  void (*ResetTxQueueStats)(void);
+  void (*SetTxDoubleBuffer)(bool enable);
+#endif
+#if RADIO_FEATURE_PROFILES
+  void (*BuildProfile)(RadioProfile_t *profile, const RadioProfileParams_t *params);
+  uint8_t (*ApplyProfile)(const RadioProfile_t *profile);
+#endif
+#if RADIO_HOP_CHANNELS > 0
+  uint8_t (*SetHopChannels)(const uint32_t *frequencies, uint8_t count);
+  void (*SetHopSequence)(const uint8_t *sequence, uint8_t length);
+  void (*SetHopTrigger)(uint8_t triggers);
+  uint8_t (*Hop)(void);
+  RadioHopStats_t (*GetHopStats)(void);
+  void (*ResetHopStats)(void);
+#endif
+#if RADIO_FEATURE_RANGING
+  int32_t (*GetRangingResultQ8)(RadioRangingResultTypes_t resultType);
+  int32_t (*RangingShortRangeCorrection)(int32_t distance, int8_t rssi);
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_STATS_SIZE > 0 )
+  void (*RangingStatsReset)(RadioRangingStats_t *stats);
+  bool (*RangingStatsAdd)(RadioRangingStats_t *stats, int32_t distance, int8_t rssi);
+  bool (*RangingStatsGetResult)(const RadioRangingStats_t *stats, uint8_t minAccepted, RadioRangingStatsResult_t *result);
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+  uint8_t (*SetRangingAnchors)(const uint32_t *addresses, uint8_t count);
+  void (*StartRangingScheduler)(uint32_t slotTime, TickTime_t timeout);
+  void (*StopRangingScheduler)(void);
+  bool (*GetRangingRound)(RadioRangingRound_t *round);
+  RadioRangingSchedulerStats_t (*GetRangingSchedulerStats)(void);
+  void (*ResetRangingSchedulerStats)(void);
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+  void (*StartContinuousRanging)(TickTime_t timeout);
+  void (*StopContinuousRanging)(void);
+  bool (*ReadRangingSample)(RadioRangingSample_t *sample);
+  RadioContinuousRangingStats_t (*GetContinuousRangingStats)(void);
+  void (*ResetContinuousRangingStats)(void);
+#endif
+#if RADIO_FEATURE_RANGING
+  bool (*SetRangingProfile)(RadioLoRaBandwidths_t bandwidth, RadioLoRaSpreadingFactors_t spreadingFactor);
+  int16_t (*GetRangingFeiGradient)(void);
+  RadioRangingResult_t (*GetCompensatedRangingResult)(RadioRangingResultTypes_t resultType);
+#endif
+} Radio_t;
+
+static const Radio_t Radio = {
+  __Init,
+  __SetPollingMode,
+  __SetInterruptMode,
+  __SetRegistersDefault,
+  __GetFirmwareVersion,
+  __Reset,
+  __Wakeup,
+  __WriteCommand,
+  __ReadCommand,
+  __WriteRegister,
+  __ReadRegister,
+  __WriteBuffer,
+  __ReadBuffer,
+  __GetDioStatus,
+  __GetOpMode,
+  __GetStatus,
+  __SetSleep,
+  __SetStandby,
+  __SetFs,
+  __SetTx,
+  __SetRx,
+  __SetRxDutyCycle,
+  __SetCad,
+  __SetTxContinuousWave,
+  __SetTxContinuousPreamble,
+  __SetPacketType,
+  __GetPacketType,
+  __SetRfFrequency,
+  __SetTxParams,
+  __SetCadParams,
+  __SetBufferBaseAddresses,
+  __SetModulationParams,
+  __SetPacketParams,
+  __GetRxBufferStatus,
+  __GetPacketStatus,
+  __GetRssiInst,
+  __SetDioIrqParams,
+  __GetIrqStatus,
+  __ClearIrqStatus,
+  __Calibrate,
+  __SetRegulatorMode,
+  __SetSaveContext,
+  __SetAutoTx,
+  __SetAutoFs,
+  __SetLongPreamble,
+  __SetPayload,
+  __GetPayload,
+  __SendPayload,
+#if RADIO_FEATURE_SYNC_WORD
+  __SetSyncWord,
+  __SetSyncWordErrorTolerance,
+  __SetCrcSeed,
+#endif
+#if RADIO_FEATURE_BLE
+  __SetBleAccessAddress,
+  __SetBleAdvertizerAccessAddress,
+#endif
+#if RADIO_FEATURE_SYNC_WORD
+  __SetCrcPolynomial,
+  __SetWhiteningSeed,
+#endif
+#if RADIO_FEATURE_RANGING
+  __SetRangingIdLength,
+  __SetDeviceRangingAddress,
+  __SetRangingRequestAddress,
+  __GetRangingResult,
+  __SetRangingCalibration,
+  __RangingClearFilterResult,
+  __RangingSetFilterNumSamples,
+#endif
+  __GetFrequencyError,
+  __ProcessIrqs,
+  __ForcePreambleLength,
+  __GetSpiTransactionCount,
+  __ResetSpiTransactionCount,
+  __SetTransport,
+  __WaitForIrq,
+  __SetRegisterCache,
+  __GetRegisterCacheStats,
+  __ResetRegisterCacheStats,
+  __ReadRegisterRange,
+  __Poll,
+  __Dispatch,
+  __GetDroppedEvents,
+  __SetBusyWaitParams,
+  __GetLastError,
+  __DumpBusyHistogram,
+  __ResetBusyHistogram,
+  __SetLazyBusy,
+#if RADIO_PACKET_POOL_SIZE > 0
+  __SetPacketPool,
+  __GetRxPacket,
+  __ReleasePacket,
+  __GetFreePackets,
+#endif
+  __ReadRxFrame,
+#if RADIO_TX_QUEUE_SIZE > 0
+  __EnqueuePayload,
+  __GetTxQueueCount,
+  __GetTxQueueStats,
+  __ResetTxQueueStats,
+  __SetTxDoubleBuffer,
+#endif
+#if RADIO_FEATURE_PROFILES
+  __BuildProfile,
+  __ApplyProfile,
+#endif
+#if RADIO_HOP_CHANNELS > 0
+  __SetHopChannels,
+  __SetHopSequence,
+  __SetHopTrigger,
+  __Hop,
+  __GetHopStats,
+  __ResetHopStats,
+#endif
+#if RADIO_FEATURE_RANGING
+  __GetRangingResultQ8,
+  __RangingShortRangeCorrection,
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_STATS_SIZE > 0 )
+  __RangingStatsReset,
+  __RangingStatsAdd,
+  __RangingStatsGetResult,
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+  __SetRangingAnchors,
+  __StartRangingScheduler,
+  __StopRangingScheduler,
+  __GetRangingRound,
+  __GetRangingSchedulerStats,
+  __ResetRangingSchedulerStats,
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+  __StartContinuousRanging,
+  __StopContinuousRanging,
+  __ReadRangingSample,
+  __GetContinuousRangingStats,
+  __ResetContinuousRangingStats,
+#endif
+#if RADIO_FEATURE_RANGING
+  __SetRangingProfile,
+  __GetRangingFeiGradient,
+  __GetCompensatedRangingResult,
+#endif
+};
+
+#endif /* __RADIO_H__ */
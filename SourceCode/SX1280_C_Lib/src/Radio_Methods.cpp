@@ -0,0 +1,3765 @@
+#include "Config.h"
+#include "Radio_Methods.h"
+#include "Transport.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#ifdef ARDUINO
+#include "Arduino.h"
+#endif
+
+#if RADIO_FEATURE_DEBUG
+#ifdef ARDUINO
+#define RADIO_TRACE( label, value )                 do { Serial.print( label ); Serial.println( value ); } while( 0 )
+#else
+#define RADIO_TRACE( label, value )                 printf( "%s%f\n", label, ( double )( value ) )
+#endif
+#else
+#define RADIO_TRACE( label, value )
+#endif
+
+static RadioCallbacks_t *__callbacks = NULL;
+static bool __IrqState = false;
+static bool __PollingMode = false;
+static RadioOperatingModes_t __OperatingMode = MODE_STDBY_RC;
+static RadioPacketTypes_t __PacketType = PACKET_TYPE_NONE;
+static RadioLoRaBandwidths_t __LoRaBandwidth = LORA_BW_1600;
+static RadioLoRaPacketLengthsModes_t __LoRaHeaderType = LORA_PACKET_VARIABLE_LENGTH;
+static uint8_t __LoRaPayloadLength = 0;
+
+/*!
+   \brief Last packet parameters written to the radio
+*/
+static PacketParams_t __PacketParams;
+static uint8_t __TxBaseAddress = 0x00;
+static uint8_t __RxBaseAddress = 0x00;
+
+#if RADIO_SPI_FRAME_SIZE < 16
+#error "RADIO_SPI_FRAME_SIZE must hold the longest command, 16 bytes at least"
+#endif
+
+/*!
+   \brief Longest register access sent in one frame, longer ones are split
+   into consecutive accesses on the following addresses
+*/
+#define RADIO_REGISTER_CHUNK_SIZE                   ( RADIO_SPI_FRAME_SIZE - 4 )
+
+/*!
+   \brief Longest data buffer access sent in one frame, longer ones are
+   split into consecutive accesses on the following offsets
+*/
+#define RADIO_BUFFER_CHUNK_SIZE                     ( RADIO_SPI_FRAME_SIZE - 3 )
+
+/*!
+   \brief Holds the whole SPI frame of the current command so that it is sent
+   in a single block transfer under one chip select
+*/
+static uint8_t __SpiFrame[RADIO_SPI_FRAME_SIZE];
+static uint32_t __SpiTransactionCount = 0;
+
+#ifdef ARDUINO
+static const RadioTransport_t *__Transport = &ArduinoTransport;
+#else
+static const RadioTransport_t *__Transport = &LoopbackTransport;
+#endif
+/*!
+   \brief Registers only modified through the driver, whose value can be kept
+   in the shadow cache
+
+   \remark Registers the radio updates on its own (ranging results, frequency
+           error, ...) must never be listed here
+*/
+static const uint16_t RadioCachedRegs[] = {
+  REG_LR_PACKETPARAMS,
+  REG_LR_PREAMBLELENGTH,
+  REG_LR_SYNCWORDTOLERANCE,
+  REG_LR_RANGINGIDCHECKLENGTH,
+  REG_LR_RANGINGRESULTCONFIG,
+  REG_LR_RANGINGRESULTCLEARREG
+};
+#define RADIO_CACHED_REGS_COUNT                     ( sizeof( RadioCachedRegs ) / sizeof( uint16_t ) )
+
+static bool __RegCacheEnabled = false;
+static uint16_t __RegCacheValid = 0;
+static uint8_t __RegCacheValue[RADIO_CACHED_REGS_COUNT];
+static RadioRegCacheStats_t __RegCacheStats = { 0, 0, 0 };
+
+#if ( RADIO_IRQ_QUEUE_SIZE & ( RADIO_IRQ_QUEUE_SIZE - 1 ) ) != 0
+#error "RADIO_IRQ_QUEUE_SIZE must be a power of 2"
+#endif
+
+#if ( RADIO_EVENT_QUEUE_SIZE & ( RADIO_EVENT_QUEUE_SIZE - 1 ) ) != 0
+#error "RADIO_EVENT_QUEUE_SIZE must be a power of 2"
+#endif
+
+/*!
+   \brief Single producer (DIO1 interrupt) / single consumer (Poll) ring of
+   DIO1 edge timestamps, no lock needed as each index has only one writer
+*/
+static volatile uint32_t __IrqQueue[RADIO_IRQ_QUEUE_SIZE];
+static volatile uint8_t __IrqQueueHead = 0;
+static volatile uint8_t __IrqQueueTail = 0;
+
+/*!
+   \brief Events decoded from the IRQ status, only touched from the main loop
+*/
+static RadioEvent_t __EventQueue[RADIO_EVENT_QUEUE_SIZE];
+static uint8_t __EventQueueHead = 0;
+static uint8_t __EventQueueTail = 0;
+static uint16_t __DroppedEvents = 0;
+
+/*!
+   \brief DIO1 edges dropped by the interrupt on a full ring, only written by
+   the interrupt so that no increment of __DroppedEvents is lost
+*/
+static volatile uint16_t __DroppedIrqs = 0;
+
+static RadioBusyWaitParams_t __BusyWaitParams = { BUSY_WAIT_SPIN_COUNT, BUSY_WAIT_YIELD_COUNT, BUSY_WAIT_SLEEP_TIME, BUSY_WAIT_TIMEOUT };
+static RadioErrors_t __LastError = RADIO_ERROR_NONE;
+
+/*!
+   \brief Opcode of the last frame sent, the first BUSY wait following it is
+   accounted to this opcode
+*/
+static uint8_t __LastOpcode = RADIO_GET_STATUS;
+static bool __BusyWaitPending = false;
+
+/*!
+   \brief When set, the BUSY wait following a command is left to the start
+   of the next transaction
+*/
+static bool __LazyBusy = false;
+
+#if RADIO_PACKET_POOL_SIZE > 16
+#error "RADIO_PACKET_POOL_SIZE must not exceed 16"
+#endif
+
+#if RADIO_PACKET_POOL_SIZE > 0
+/*!
+   \brief Slots the RX payloads are read into, only touched from the main
+   loop. A set bit of __PacketPoolFree marks a free slot
+*/
+static RadioPacket_t __PacketPool[RADIO_PACKET_POOL_SIZE];
+static uint16_t __PacketPoolFree = ( uint16_t )( ( 1UL << RADIO_PACKET_POOL_SIZE ) - 1 );
+static bool __PacketPoolEnabled = false;
+
+/*!
+   \brief Packet of the RX done event being dispatched, released after the
+   rxDone callback unless taken with GetRxPacket( )
+*/
+static RadioPacket_t *__DispatchedPacket = NULL;
+#endif
+
+/*!
+   \brief Size of each half of the data buffer in the TX double buffer mode
+*/
+#define RADIO_TX_BUFFER_HALF                        0x80
+
+#if RADIO_INTEGER_FREQUENCY && ( XTAL_FREQ != 52000000 )
+#error "FREQ_STEP_MULTIPLIER assumes a 52 MHz XTAL_FREQ, set RADIO_INTEGER_FREQUENCY to 0"
+#endif
+
+#if ( RADIO_TX_QUEUE_SIZE & ( RADIO_TX_QUEUE_SIZE - 1 ) ) != 0
+#error "RADIO_TX_QUEUE_SIZE must be a power of 2"
+#endif
+
+#if RADIO_RANGING_STATS_SIZE > 255
+#error "RADIO_RANGING_STATS_SIZE must not exceed 255"
+#endif
+
+#if ( RADIO_RANGING_RESULTS & ( RADIO_RANGING_RESULTS - 1 ) ) != 0
+#error "RADIO_RANGING_RESULTS must be a power of 2"
+#endif
+
+#if RADIO_TX_QUEUE_SIZE > 0
+/*!
+   \brief Frame waiting in the TX queue, the payload stays in the caller's
+   memory until its TX done or TX timeout event
+*/
+typedef struct
+{
+  uint8_t *Payload;
+  uint8_t Size;
+  TickTime_t Timeout;
+  uint32_t EnqueueTime;
+} RadioTxFrame_t;
+
+/*!
+   \brief Frames queued by EnqueuePayload( ), the head one is on air while
+   __TxQueueBusy is set. Only touched from the main loop
+*/
+static RadioTxFrame_t __TxQueue[RADIO_TX_QUEUE_SIZE];
+static uint8_t __TxQueueHead = 0;
+static uint8_t __TxQueueTail = 0;
+static bool __TxQueueBusy = false;
+static uint32_t __TxQueueLatency = 0;
+static RadioTxQueueStats_t __TxQueueStats = { 0, 0, 0, 0 };
+
+/*!
+   \brief Double buffer mode, the frame following the one on air is
+   preloaded in the other half of the data buffer, at __TxBaseAddress ^ 0x80
+*/
+static bool __TxDoubleBuffer = false;
+static bool __TxQueuePreloaded = false;
+
+/*!
+   \brief Payload length of the application, saved while the radio uses the
+   length of the queued frames
+*/
+static uint8_t __TxQueueSavedLength = 0;
+static bool __TxQueueLengthSet = false;
+
+/*!
+   \brief Payload length field of the packet parameters, NULL for BLE which
+   takes the length from the PDU header
+*/
+uint8_t *PacketParamsLength(PacketParams_t *packetParams)
+{
+  switch ( packetParams->PacketType )
+  {
+#if RADIO_FEATURE_GFSK
+    case PACKET_TYPE_GFSK:
+      return &packetParams->Params.Gfsk.PayloadLength;
+#endif
+#if RADIO_FEATURE_FLRC
+    case PACKET_TYPE_FLRC:
+      return &packetParams->Params.Flrc.PayloadLength;
+#endif
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+      return &packetParams->Params.LoRa.PayloadLength;
+    default:
+      return NULL;
+  }
+}
+
+/*!
+   \brief Gives the radio back the payload length of the application, once
+   the queue is empty or before a reception
+*/
+void TxQueueRestoreLength(void)
+{
+  PacketParams_t packetParams;
+  uint8_t *length;
+
+  if ( __TxQueueLengthSet == false )
+  {
+    return;
+  }
+  packetParams = __PacketParams;
+  length = PacketParamsLength( &packetParams );
+  if ( length != NULL )
+  {
+    *length = __TxQueueSavedLength;
+  }
+  // Clears __TxQueueLengthSet
+  __SetPacketParams( &packetParams );
+}
+#endif
+
+#if RADIO_HOP_CHANNELS > 0
+/*!
+   \brief Hop engine: SetRfFrequency parameters of every channel, computed
+   once by SetHopChannels( ), and the optional sequence of channel indexes
+   walked instead of the channel order
+*/
+static uint8_t __HopSteps[RADIO_HOP_CHANNELS][3];
+static uint8_t __HopChannels = 0;
+static const uint8_t *__HopSequence = NULL;
+static uint8_t __HopSequenceLength = 0;
+static uint8_t __HopPosition = 0;
+static uint8_t __HopTriggers = RADIO_HOP_MANUAL;
+static RadioHopStats_t __HopStats = { 0, 0, 0 };
+#endif
+
+#if RADIO_FEATURE_RANGING
+#include "RangingCalibration.h"
+
+/*!
+   \brief Frequency error gradient of the ranging profile [mm/kHz], see
+   SetRangingProfile( )
+*/
+static int16_t __RangingFeiGradient = 0;
+#endif
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+/*!
+   \brief Ranging scheduler: request address of every anchor as written to
+   the radio, the anchor of the current or next slot, and the SetTx
+   parameters sent at each slot start
+*/
+static uint8_t __Anchors[RADIO_RANGING_ANCHORS][4];
+static uint8_t __AnchorCount = 0;
+static uint8_t __AnchorSlot = 0;
+static uint8_t __SchedulerTx[3];
+static bool __SchedulerRunning = false;
+static bool __SchedulerSlotBusy = false;
+
+/*!
+   \brief Slot length [us], 0 starting each slot as soon as the previous one
+   ends, the time the next slot is due and the time the current one started
+*/
+static uint32_t __SchedulerSlotTime = 0;
+static uint32_t __SchedulerSlotDue = 0;
+static uint32_t __SchedulerSlotStart = 0;
+
+/*!
+   \brief Round being filled and last completed round, not yet read when
+   __RangingRoundReady is set
+*/
+static RadioRangingRound_t __RangingRound;
+static RadioRangingRound_t __RangingRoundDone;
+static bool __RangingRoundReady = false;
+static RadioRangingSchedulerStats_t __SchedulerStats = { 0, 0, 0, 0, 0, 0, 0 };
+#endif
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+/*!
+   \brief Continuous ranging: SetTx parameters re-sent as soon as an exchange
+   ends, and the results waiting to be read, filled from Poll( )
+*/
+static uint8_t __ContinuousTx[3];
+static bool __ContinuousRanging = false;
+static RadioRangingSample_t __RangingSamples[RADIO_RANGING_RESULTS];
+static uint8_t __RangingSamplesHead = 0;
+static uint8_t __RangingSamplesTail = 0;
+static RadioContinuousRangingStats_t __ContinuousStats = { 0, 0, 0, 0, 0 };
+#endif
+
+#if RADIO_FEATURE_PROFILES
+/*!
+   \brief Place of a profile command in RadioProfile_t.Commands: the opcode
+   at Offset followed by Size bytes of parameters
+*/
+typedef struct
+{
+  uint8_t Opcode;
+  uint8_t Offset;
+  uint8_t Size;
+} RadioProfileCommand_t;
+
+typedef enum
+{
+  PROFILE_PACKET_TYPE,
+  PROFILE_MODULATION_PARAMS,
+  PROFILE_PACKET_PARAMS,
+  PROFILE_RF_FREQUENCY,
+  PROFILE_BUFFER_BASE_ADDRESS,
+  PROFILE_TX_PARAMS,
+  PROFILE_DIO_IRQ_PARAMS,
+} RadioProfileCommands_t;
+
+/*!
+   \brief Profile commands in the order they are sent, the packet type first
+*/
+static const RadioProfileCommand_t RadioProfileCommands[RADIO_PROFILE_COMMANDS] = {
+  { RADIO_SET_PACKETTYPE, 0, 1 },
+  { RADIO_SET_MODULATIONPARAMS, 2, 3 },
+  { RADIO_SET_PACKETPARAMS, 6, 7 },
+  { RADIO_SET_RFFREQUENCY, 14, 3 },
+  { RADIO_SET_BUFFERBASEADDRESS, 18, 2 },
+  { RADIO_SET_TXPARAMS, 21, 2 },
+  { RADIO_SET_DIOIRQPARAMS, 24, 8 },
+};
+
+/*!
+   \brief Last frame sent for each profile command, whatever the path, bit i
+   of __ProfileShadowValid tells the frame of command i is known
+*/
+static uint8_t __ProfileShadow[RADIO_PROFILE_SIZE];
+static uint8_t __ProfileShadowValid = 0;
+#endif
+
+#ifdef BUSY_WAIT_HISTOGRAM
+/*!
+   \brief Number of buckets per opcode, bucket n counts the waits lasting
+   [ 2^(n-1), 2^n [ us and the last one all the longer waits
+*/
+#define BUSY_HISTOGRAM_BUCKETS                      16
+
+static const uint8_t BusyHistogramOpcodes[] = {
+  RADIO_GET_STATUS, RADIO_WRITE_REGISTER, RADIO_READ_REGISTER, RADIO_WRITE_BUFFER,
+  RADIO_READ_BUFFER, RADIO_SET_SLEEP, RADIO_SET_STANDBY, RADIO_SET_FS,
+  RADIO_SET_TX, RADIO_SET_RX, RADIO_SET_RXDUTYCYCLE, RADIO_SET_CAD,
+  RADIO_SET_TXCONTINUOUSWAVE, RADIO_SET_TXCONTINUOUSPREAMBLE, RADIO_SET_PACKETTYPE, RADIO_GET_PACKETTYPE,
+  RADIO_SET_RFFREQUENCY, RADIO_SET_TXPARAMS, RADIO_SET_CADPARAMS, RADIO_SET_BUFFERBASEADDRESS,
+  RADIO_SET_MODULATIONPARAMS, RADIO_SET_PACKETPARAMS, RADIO_GET_RXBUFFERSTATUS, RADIO_GET_PACKETSTATUS,
+  RADIO_GET_RSSIINST, RADIO_SET_DIOIRQPARAMS, RADIO_GET_IRQSTATUS, RADIO_CLR_IRQSTATUS,
+  RADIO_CALIBRATE, RADIO_SET_REGULATORMODE, RADIO_SET_SAVECONTEXT, RADIO_SET_AUTOTX,
+  RADIO_SET_AUTOFS, RADIO_SET_LONGPREAMBLE, RADIO_SET_UARTSPEED, RADIO_SET_RANGING_ROLE
+};
+#define BUSY_HISTOGRAM_OPCODES                      ( sizeof( BusyHistogramOpcodes ) / sizeof( uint8_t ) )
+
+static uint16_t __BusyHistogram[BUSY_HISTOGRAM_OPCODES][BUSY_HISTOGRAM_BUCKETS];
+#endif
+
+/*!
+   \brief Radio registers definition
+
+*/
+typedef struct
+{
+  uint16_t      Addr;                             //!< The address of the register
+  uint8_t       Value;                            //!< The value of the register
+} RadioRegisters_t;
+
+/*!
+   \brief Radio hardware registers initialization definition
+*/
+#define RADIO_INIT_REGISTERS_VALUE  { }
+
+/*!
+   \brief Radio hardware registers initialization
+*/
+const RadioRegisters_t RadioRegsInit[] = RADIO_INIT_REGISTERS_VALUE;
+
+/*!
+   \brief Sends a complete frame to the radio in one block transfer
+
+   \remark The received bytes overwrite the frame content
+*/
+void SpiTransfer(uint8_t *frame, uint16_t size)
+{
+  __LastOpcode = frame[0];
+  __BusyWaitPending = true;
+
+  __Transport->ChipSelect(true);    // RadioNss = 0;
+  __Transport->Transfer(frame, size);
+  __Transport->ChipSelect(false);   // RadioNss = 1;
+
+  __SpiTransactionCount++;
+}
+
+/*!
+   \brief Returns the index of a register in the shadow cache, -1 if it is not cacheable
+*/
+int8_t RegCacheIndex(uint16_t address)
+{
+  for ( uint8_t i = 0; i < RADIO_CACHED_REGS_COUNT; i++ )
+  {
+    if ( RadioCachedRegs[i] == address )
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*!
+   \brief Drops every cached value, to be called when the radio may have
+   changed its registers (reset, sleep, packet configuration)
+*/
+void RegCacheInvalidate(void)
+{
+  __RegCacheValid = 0;
+}
+
+/*!
+   \brief Stores the values just written to or read from the radio
+*/
+void RegCacheUpdate(uint16_t address, const uint8_t *buffer, uint16_t size)
+{
+  if ( __RegCacheEnabled == false )
+  {
+    return;
+  }
+  for ( uint16_t i = 0; i < size; i++ )
+  {
+    int8_t idx = RegCacheIndex( address + i );
+    if ( idx >= 0 )
+    {
+      __RegCacheValue[idx] = buffer[i];
+      __RegCacheValid |= ( 1 << idx );
+    }
+  }
+}
+
+/*!
+   \brief Serves a register read from the cache
+
+   \retval      hit           True if every register was cached, buffer is then filled
+*/
+bool RegCacheLookup(uint16_t address, uint8_t *buffer, uint16_t size)
+{
+  bool cacheable = true;
+  bool valid = true;
+
+  for ( uint16_t i = 0; i < size; i++ )
+  {
+    int8_t idx = RegCacheIndex( address + i );
+    if ( idx < 0 )
+    {
+      cacheable = false;
+      break;
+    }
+    if ( ( __RegCacheValid & ( 1 << idx ) ) == 0 )
+    {
+      valid = false;
+    }
+  }
+
+  if ( cacheable == false )
+  {
+    __RegCacheStats.Uncached++;
+    return false;
+  }
+  if ( valid == false )
+  {
+    __RegCacheStats.Misses++;
+    return false;
+  }
+  for ( uint16_t i = 0; i < size; i++ )
+  {
+    buffer[i] = __RegCacheValue[RegCacheIndex( address + i )];
+  }
+  __RegCacheStats.Hits++;
+  return true;
+}
+
+#if RADIO_FEATURE_PROFILES
+/*!
+   \brief Forgets the configuration commands sent so far, to be called when
+   the radio may have lost it (reset, sleep)
+*/
+void ProfileShadowInvalidate(void)
+{
+  __ProfileShadowValid = 0;
+}
+
+/*!
+   \brief Records a configuration command just sent to the radio
+*/
+void ProfileShadowUpdate(uint8_t opcode, const uint8_t *buffer, uint16_t size)
+{
+  for ( uint8_t i = 0; i < RADIO_PROFILE_COMMANDS; i++ )
+  {
+    const RadioProfileCommand_t *command = &RadioProfileCommands[i];
+
+    if ( command->Opcode != opcode )
+    {
+      continue;
+    }
+    if ( size != command->Size )
+    {
+      __ProfileShadowValid &= ~( 1 << i );
+      return;
+    }
+    if ( ( i == PROFILE_PACKET_TYPE ) &&
+         ( ( ( __ProfileShadowValid & ( 1 << i ) ) == 0 ) || ( __ProfileShadow[command->Offset + 1] != buffer[0] ) ) )
+    {
+      // Modulation and packet parameters are interpreted per packet type,
+      // send them again after a change
+      __ProfileShadowValid &= ~( ( 1 << PROFILE_MODULATION_PARAMS ) | ( 1 << PROFILE_PACKET_PARAMS ) );
+    }
+    __ProfileShadow[command->Offset] = opcode;
+    memcpy( &__ProfileShadow[command->Offset + 1], buffer, size );
+    __ProfileShadowValid |= ( 1 << i );
+    return;
+  }
+}
+#endif
+
+/*!
+   \brief DIO1 interrupt handler, only records the time of the edge
+*/
+void OnDioIrq(void)
+{
+  uint8_t head = __IrqQueueHead;
+
+  if ( __PollingMode == true )
+  {
+    __IrqState = true;
+    return;
+  }
+  if ( ( uint8_t )( head - __IrqQueueTail ) >= RADIO_IRQ_QUEUE_SIZE )
+  {
+    __DroppedIrqs++;
+    return;
+  }
+  __IrqQueue[head & ( RADIO_IRQ_QUEUE_SIZE - 1 )] = __Transport->GetTime( );
+  __IrqQueueHead = head + 1;
+}
+
+#ifdef BUSY_WAIT_HISTOGRAM
+/*!
+   \brief Counts a BUSY wait of the given duration [us] for an opcode
+*/
+void BusyHistogramRecord(uint8_t opcode, uint32_t time)
+{
+  uint8_t bucket = 0;
+
+  for ( uint8_t i = 0; i < BUSY_HISTOGRAM_OPCODES; i++ )
+  {
+    if ( BusyHistogramOpcodes[i] == opcode )
+    {
+      while ( ( time > 0 ) && ( bucket < ( BUSY_HISTOGRAM_BUCKETS - 1 ) ) )
+      {
+        time >>= 1;
+        bucket++;
+      }
+      if ( __BusyHistogram[i][bucket] < 0xFFFF )
+      {
+        __BusyHistogram[i][bucket]++;
+      }
+      return;
+    }
+  }
+}
+#endif
+
+/*!
+   \brief Waits for the BUSY line to go low, following __BusyWaitParams
+
+   \retval released  false when the timeout was reached, the error is then
+                     reported by __GetLastError( )
+*/
+bool WaitOnBusy(void)
+{
+  uint32_t start;
+  uint32_t elapsed = 0;
+  uint32_t polls = 0;
+  bool released = true;
+
+  if ( __Transport->ReadBusy( ) )
+  {
+    start = __Transport->GetTime( );
+    while ( __Transport->ReadBusy( ) )
+    {
+      elapsed = __Transport->GetTime( ) - start;
+      if ( ( __BusyWaitParams.Timeout != 0 ) && ( elapsed >= __BusyWaitParams.Timeout ) )
+      {
+        __LastError = RADIO_ERROR_BUSY_TIMEOUT;
+        released = false;
+        break;
+      }
+      if ( polls < __BusyWaitParams.SpinCount )
+      {
+        polls++;
+      }
+      else if ( polls < ( uint32_t )__BusyWaitParams.SpinCount + __BusyWaitParams.YieldCount )
+      {
+        polls++;
+        __Transport->Yield( );
+      }
+      else
+      {
+        __Transport->Sleep( __BusyWaitParams.SleepTime );
+      }
+    }
+    if ( released == true )
+    {
+      elapsed = __Transport->GetTime( ) - start;
+    }
+  }
+
+  // Only the first wait after a frame measures the time the command needs
+  if ( __BusyWaitPending == true )
+  {
+    __BusyWaitPending = false;
+#ifdef BUSY_WAIT_HISTOGRAM
+    BusyHistogramRecord( __LastOpcode, elapsed );
+#endif
+  }
+  return released;
+}
+
+/*!
+   \brief Waits for the end of the command just sent, unless the lazy busy
+   mode defers it to the start of the next transaction
+*/
+void WaitOnBusyAfter(void)
+{
+  if ( __LazyBusy == false )
+  {
+    WaitOnBusy( );
+  }
+}
+
+/*!
+   \brief Initializes the transport and the radio
+
+   \retval      initialized   false when the transport could not be opened,
+                              the radio must not be used then
+*/
+bool __Init(RadioCallbacks_t* callbacks)
+{
+  __callbacks = callbacks;
+
+  // GPIO and SPI Init
+  if ( __Transport->Init( ) == false )
+  {
+    return false;
+  }
+
+  // Reset
+  __Reset();
+
+  // IoIrqInit
+  __Transport->AttachIrq(OnDioIrq);
+
+  // Wakeup
+  __Wakeup();
+
+  // SetRegistersDefault
+  __SetRegistersDefault();
+  return true;
+}
+
+void __SetTransport(const RadioTransport_t *transport)
+{
+  __Transport = transport;
+}
+
+bool __WaitForIrq(uint32_t timeout)
+{
+  return __Transport->WaitForIrq(timeout);
+}
+
+void __SetPollingMode(void)
+{
+  __PollingMode = true;
+}
+
+void __SetInterruptMode(void)
+{
+  __PollingMode = false;
+}
+
+void __SetRegistersDefault(void)
+{
+  for ( uint16_t i = 0; i < sizeof( RadioRegsInit ) / sizeof( RadioRegisters_t ); i++ )
+  {
+    uint8_t value = RadioRegsInit[i].Value;
+    __WriteRegister( RadioRegsInit[i].Addr, &(value), 1 );
+  }
+}
+
+uint16_t __GetFirmwareVersion(void)
+{
+  return ( uint16_t )__ReadRegisterRange( REG_LR_FIRMWARE_VERSION_MSB, 2 );
+}
+
+void __Reset(void)
+{
+  RegCacheInvalidate( );
+#if RADIO_FEATURE_PROFILES
+  ProfileShadowInvalidate( );
+#endif
+  __Transport->Reset();
+}
+
+void __Wakeup(void)
+{
+  __SpiFrame[0] = RADIO_GET_STATUS;
+  __SpiFrame[1] = 0;
+  SpiTransfer(__SpiFrame, 2);
+
+  WaitOnBusy();
+}
+
+void __WriteCommand(RadioCommands_t command, uint8_t *buffer, uint16_t size)
+{
+  if ( size > RADIO_SPI_FRAME_SIZE - 1 )
+  {
+    RADIO_TRACE( "Command parameters too long: ", size );
+    return;
+  }
+  __SpiFrame[0] = (uint8_t)command;
+  memcpy(&__SpiFrame[1], buffer, size);
+
+  if ( WaitOnBusy( ) == false )
+  {
+    return;
+  }
+  SpiTransfer(__SpiFrame, size + 1);
+#if RADIO_FEATURE_PROFILES
+  ProfileShadowUpdate( command, buffer, size );
+#endif
+
+  if (command != RADIO_SET_SLEEP)
+  {
+    WaitOnBusyAfter( );
+  }
+}
+
+void __ReadCommand(RadioCommands_t command, uint8_t *buffer, uint16_t size)
+{
+  uint16_t offset = 2;
+  uint16_t length = size + 2;
+
+  if (command == RADIO_GET_STATUS)
+  {
+    // The status is clocked out while the opcode itself is sent
+    offset = 0;
+    length = 3;
+    size = 1;
+  }
+  else if ( length > RADIO_SPI_FRAME_SIZE )
+  {
+    RADIO_TRACE( "Command response too long: ", size );
+    memset(buffer, 0, size);
+    return;
+  }
+  __SpiFrame[0] = (uint8_t)command;
+  memset(&__SpiFrame[1], 0, length - 1);
+
+  if ( WaitOnBusy( ) == false )
+  {
+    memset(buffer, 0, size);
+    return;
+  }
+  SpiTransfer(__SpiFrame, length);
+  memcpy(buffer, &__SpiFrame[offset], size);
+
+  WaitOnBusyAfter( );
+}
+
+/*!
+   \brief Writes at most RADIO_REGISTER_CHUNK_SIZE registers in one frame
+*/
+void WriteRegisterFrame(uint16_t address, uint8_t *buffer, uint16_t size)
+{
+  __SpiFrame[0] = RADIO_WRITE_REGISTER;
+  __SpiFrame[1] = ( address & 0xFF00 ) >> 8;
+  __SpiFrame[2] = address & 0x00FF;
+  memcpy(&__SpiFrame[3], buffer, size);
+
+  if ( WaitOnBusy( ) == false )
+  {
+    return;
+  }
+  SpiTransfer(__SpiFrame, size + 3);
+
+  WaitOnBusyAfter( );
+
+  RegCacheUpdate( address, buffer, size );
+}
+
+void __WriteRegister(uint16_t address, uint8_t *buffer, uint16_t size)
+{
+  uint16_t chunk;
+
+  do
+  {
+    chunk = ( size > RADIO_REGISTER_CHUNK_SIZE ) ? RADIO_REGISTER_CHUNK_SIZE : size;
+    WriteRegisterFrame( address, buffer, chunk );
+    address += chunk;
+    buffer += chunk;
+    size -= chunk;
+  } while ( size > 0 );
+}
+
+void __WriteRegister_1(uint16_t address, uint8_t value)
+{
+  __WriteRegister(address, &value, 1);
+}
+
+/*!
+   \brief Reads at most RADIO_REGISTER_CHUNK_SIZE registers in one frame
+*/
+void ReadRegisterFrame(uint16_t address, uint8_t *buffer, uint16_t size)
+{
+  __SpiFrame[0] = RADIO_READ_REGISTER;
+  __SpiFrame[1] = ( address & 0xFF00 ) >> 8;
+  __SpiFrame[2] = address & 0x00FF;
+  memset(&__SpiFrame[3], 0, size + 1);
+
+  if ( WaitOnBusy( ) == false )
+  {
+    memset(buffer, 0, size);
+    return;
+  }
+  SpiTransfer(__SpiFrame, size + 4);
+  memcpy(buffer, &__SpiFrame[4], size);
+
+  WaitOnBusyAfter( );
+
+  RegCacheUpdate( address, buffer, size );
+}
+
+void __ReadRegister(uint16_t address, uint8_t *buffer, uint16_t size)
+{
+  if ( ( __RegCacheEnabled == true ) && ( RegCacheLookup( address, buffer, size ) == true ) )
+  {
+    return;
+  }
+
+  uint16_t chunk;
+
+  do
+  {
+    chunk = ( size > RADIO_REGISTER_CHUNK_SIZE ) ? RADIO_REGISTER_CHUNK_SIZE : size;
+    ReadRegisterFrame( address, buffer, chunk );
+    address += chunk;
+    buffer += chunk;
+    size -= chunk;
+  } while ( size > 0 );
+}
+
+uint8_t __ReadRegister_1(uint16_t address)
+{
+  uint8_t reg = 0;
+  __ReadRegister(address, &reg, 1);
+  return reg;
+}
+
+uint32_t __ReadRegisterRange(uint16_t address, uint8_t size)
+{
+  uint8_t regs[4] = { 0 };
+  uint32_t value = 0;
+
+  if ( size > 4 )
+  {
+    size = 4;
+  }
+  // Contiguous registers are fetched in a single transaction, MSB first
+  __ReadRegister( address, regs, size );
+  for ( uint8_t i = 0; i < size; i++ )
+  {
+    value = ( value << 8 ) | regs[i];
+  }
+  return value;
+}
+
+/*!
+   \brief Writes at most RADIO_BUFFER_CHUNK_SIZE bytes of the data buffer
+   in one frame
+*/
+void WriteBufferFrame(uint8_t offset, uint8_t *buffer, uint8_t size)
+{
+  __SpiFrame[0] = RADIO_WRITE_BUFFER;
+  __SpiFrame[1] = offset;
+  memcpy(&__SpiFrame[2], buffer, size);
+
+  if ( WaitOnBusy( ) == false )
+  {
+    return;
+  }
+  SpiTransfer(__SpiFrame, size + 2);
+
+  WaitOnBusyAfter( );
+}
+
+void __WriteBuffer(uint8_t offset, uint8_t *buffer, uint8_t size)
+{
+  uint8_t chunk;
+
+  do
+  {
+    chunk = ( size > RADIO_BUFFER_CHUNK_SIZE ) ? RADIO_BUFFER_CHUNK_SIZE : size;
+    WriteBufferFrame( offset, buffer, chunk );
+    offset += chunk;
+    buffer += chunk;
+    size -= chunk;
+  } while ( size > 0 );
+}
+
+/*!
+   \brief Reads at most RADIO_BUFFER_CHUNK_SIZE bytes of the data buffer in
+   one frame
+*/
+void ReadBufferFrame(uint8_t offset, uint8_t *buffer, uint8_t size)
+{
+  __SpiFrame[0] = RADIO_READ_BUFFER;
+  __SpiFrame[1] = offset;
+  memset(&__SpiFrame[2], 0, size + 1);
+
+  if ( WaitOnBusy( ) == false )
+  {
+    memset(buffer, 0, size);
+    return;
+  }
+  SpiTransfer(__SpiFrame, size + 3);
+  memcpy(buffer, &__SpiFrame[3], size);
+
+  WaitOnBusyAfter( );
+}
+
+void __ReadBuffer(uint8_t offset, uint8_t *buffer, uint8_t size)
+{
+  uint8_t chunk;
+
+  do
+  {
+    chunk = ( size > RADIO_BUFFER_CHUNK_SIZE ) ? RADIO_BUFFER_CHUNK_SIZE : size;
+    ReadBufferFrame( offset, buffer, chunk );
+    offset += chunk;
+    buffer += chunk;
+    size -= chunk;
+  } while ( size > 0 );
+}
+
+uint32_t __GetSpiTransactionCount(void)
+{
+  return __SpiTransactionCount;
+}
+
+void __ResetSpiTransactionCount(void)
+{
+  __SpiTransactionCount = 0;
+}
+
+void __SetRegisterCache(bool enable)
+{
+  __RegCacheEnabled = enable;
+  RegCacheInvalidate( );
+}
+
+RadioRegCacheStats_t __GetRegisterCacheStats(void)
+{
+  return __RegCacheStats;
+}
+
+void __ResetRegisterCacheStats(void)
+{
+  __RegCacheStats.Hits = 0;
+  __RegCacheStats.Misses = 0;
+  __RegCacheStats.Uncached = 0;
+}
+
+void __SetLazyBusy(bool enable)
+{
+  __LazyBusy = enable;
+}
+
+#if RADIO_PACKET_POOL_SIZE > 0
+void __SetPacketPool(bool enable)
+{
+  __PacketPoolEnabled = enable;
+}
+
+/*!
+   \brief Takes the packet of the RX done event being dispatched, to be
+   called from the rxDone callback
+
+   \retval      packet        The packet, owned by the caller until given
+                              back with ReleasePacket( ), or NULL
+*/
+RadioPacket_t *__GetRxPacket(void)
+{
+  RadioPacket_t *packet = __DispatchedPacket;
+
+  __DispatchedPacket = NULL;
+  return packet;
+}
+
+void __ReleasePacket(RadioPacket_t *packet)
+{
+  if ( ( packet >= &__PacketPool[0] ) && ( packet < &__PacketPool[RADIO_PACKET_POOL_SIZE] ) )
+  {
+    __PacketPoolFree |= ( 1 << ( packet - &__PacketPool[0] ) );
+  }
+}
+
+uint8_t __GetFreePackets(void)
+{
+  uint8_t count = 0;
+
+  for ( uint16_t free = __PacketPoolFree; free != 0; free &= free - 1 )
+  {
+    count++;
+  }
+  return count;
+}
+#endif
+
+void __SetBusyWaitParams(RadioBusyWaitParams_t *params)
+{
+  __BusyWaitParams = *params;
+}
+
+RadioErrors_t __GetLastError(void)
+{
+  RadioErrors_t error = __LastError;
+
+  __LastError = RADIO_ERROR_NONE;
+  return error;
+}
+
+void __DumpBusyHistogram(void (*print)(const char *line))
+{
+#ifdef BUSY_WAIT_HISTOGRAM
+  char line[8 + BUSY_HISTOGRAM_BUCKETS * 6];
+  int len;
+
+  // Header holds the lower bound of each bucket in microseconds
+  len = snprintf(line, sizeof(line), "opcode");
+  for ( uint8_t j = 0; j < BUSY_HISTOGRAM_BUCKETS; j++ )
+  {
+    len += snprintf(&line[len], sizeof(line) - len, " %5lu", ( j == 0 ) ? 0UL : ( 1UL << ( j - 1 ) ));
+  }
+  print(line);
+
+  for ( uint8_t i = 0; i < BUSY_HISTOGRAM_OPCODES; i++ )
+  {
+    uint32_t total = 0;
+
+    for ( uint8_t j = 0; j < BUSY_HISTOGRAM_BUCKETS; j++ )
+    {
+      total += __BusyHistogram[i][j];
+    }
+    if ( total == 0 )
+    {
+      continue;
+    }
+    len = snprintf(line, sizeof(line), "  0x%02X", BusyHistogramOpcodes[i]);
+    for ( uint8_t j = 0; j < BUSY_HISTOGRAM_BUCKETS; j++ )
+    {
+      len += snprintf(&line[len], sizeof(line) - len, " %5u", __BusyHistogram[i][j]);
+    }
+    print(line);
+  }
+#else
+  print("BUSY wait histogram disabled, define BUSY_WAIT_HISTOGRAM in Config.h");
+#endif
+}
+
+void __ResetBusyHistogram(void)
+{
+#ifdef BUSY_WAIT_HISTOGRAM
+  memset(__BusyHistogram, 0, sizeof(__BusyHistogram));
+#endif
+}
+
+uint8_t __GetDioStatus(void)
+{
+  return __Transport->ReadDio();
+}
+
+RadioOperatingModes_t __GetOpMode(void)
+{
+  return ( __OperatingMode );
+}
+
+RadioStatus_t __GetStatus(void)
+{
+  uint8_t stat = 0;
+  RadioStatus_t status;
+
+  __ReadCommand( RADIO_GET_STATUS, ( uint8_t * )&stat, 1 );
+  status.Value = stat;
+  return ( status );
+}
+
+void __SetSleep(SleepParams_t sleepConfig)
+{
+  uint8_t sleep = ( sleepConfig.WakeUpRTC << 3 ) |
+                  ( sleepConfig.InstructionRamRetention << 2 ) |
+                  ( sleepConfig.DataBufferRetention << 1 ) |
+                  ( sleepConfig.DataRamRetention );
+
+  __OperatingMode = MODE_SLEEP;
+  RegCacheInvalidate( );
+#if RADIO_FEATURE_PROFILES
+  ProfileShadowInvalidate( );
+#endif
+  __WriteCommand( RADIO_SET_SLEEP, &sleep, 1 );
+}
+
+void __SetStandby(RadioStandbyModes_t standbyConfig)
+{
+  __WriteCommand( RADIO_SET_STANDBY, ( uint8_t* )&standbyConfig, 1 );
+  if ( standbyConfig == STDBY_RC )
+  {
+    __OperatingMode = MODE_STDBY_RC;
+  }
+  else
+  {
+    __OperatingMode = MODE_STDBY_XOSC;
+  }
+}
+
+void __SetFs(void)
+{
+  __WriteCommand( RADIO_SET_FS, 0, 0 );
+  __OperatingMode = MODE_FS;
+}
+
+/*!
+      \brief Set the role of the radio during ranging operations
+
+      \param [in]  role          Role of the radio
+*/
+#if RADIO_FEATURE_RANGING
+void __SetRangingRole( RadioRangingRoles_t role )
+{
+  uint8_t buf[1];
+
+  buf[0] = role;
+  __WriteCommand( RADIO_SET_RANGING_ROLE, &buf[0], 1 );
+}
+#endif
+
+void __SetTx(TickTime_t timeout)
+{
+  uint8_t buf[3];
+  buf[0] = timeout.PeriodBase;
+  buf[1] = ( uint8_t )( ( timeout.PeriodBaseCount >> 8 ) & 0x00FF );
+  buf[2] = ( uint8_t )( timeout.PeriodBaseCount & 0x00FF );
+
+  __ClearIrqStatus( IRQ_RADIO_ALL );
+
+  // If the radio is doing ranging operations, then apply the specific calls
+  // prior to SetTx
+#if RADIO_FEATURE_RANGING
+  if ( __GetPacketType( true ) == PACKET_TYPE_RANGING )
+  {
+    __SetRangingRole( RADIO_RANGING_ROLE_MASTER );
+  }
+#endif
+  __WriteCommand( RADIO_SET_TX, buf, 3 );
+  __OperatingMode = MODE_TX;
+}
+
+void __SetRx(TickTime_t timeout)
+{
+  uint8_t buf[3];
+  buf[0] = timeout.PeriodBase;
+  buf[1] = ( uint8_t )( ( timeout.PeriodBaseCount >> 8 ) & 0x00FF );
+  buf[2] = ( uint8_t )( timeout.PeriodBaseCount & 0x00FF );
+
+#if RADIO_TX_QUEUE_SIZE > 0
+  TxQueueRestoreLength( );
+#endif
+  __ClearIrqStatus( IRQ_RADIO_ALL );
+
+  // If the radio is doing ranging operations, then apply the specific calls
+  // prior to SetRx
+#if RADIO_FEATURE_RANGING
+  if ( __GetPacketType( true ) == PACKET_TYPE_RANGING )
+  {
+    __SetRangingRole( RADIO_RANGING_ROLE_SLAVE );
+  }
+#endif
+  __WriteCommand( RADIO_SET_RX, buf, 3 );
+  __OperatingMode = MODE_RX;
+}
+
+void __SetRxDutyCycle(RadioTickSizes_t periodBase, uint16_t periodBaseCountRx, uint16_t periodBaseCountSleep)
+{
+  uint8_t buf[5];
+
+  buf[0] = periodBase;
+  buf[1] = ( uint8_t )( ( periodBaseCountRx >> 8 ) & 0x00FF );
+  buf[2] = ( uint8_t )( periodBaseCountRx & 0x00FF );
+  buf[3] = ( uint8_t )( ( periodBaseCountSleep >> 8 ) & 0x00FF );
+  buf[4] = ( uint8_t )( periodBaseCountSleep & 0x00FF );
+#if RADIO_TX_QUEUE_SIZE > 0
+  TxQueueRestoreLength( );
+#endif
+  __WriteCommand( RADIO_SET_RXDUTYCYCLE, buf, 5 );
+  __OperatingMode = MODE_RX;
+}
+
+void __SetCad(void)
+{
+  __WriteCommand( RADIO_SET_CAD, 0, 0 );
+  __OperatingMode = MODE_CAD;
+}
+
+void __SetTxContinuousWave(void)
+{
+  __WriteCommand( RADIO_SET_TXCONTINUOUSWAVE, 0, 0 );
+}
+
+void __SetTxContinuousPreamble(void)
+{
+  __WriteCommand( RADIO_SET_TXCONTINUOUSPREAMBLE, 0, 0 );
+}
+
+void __SetPacketType(RadioPacketTypes_t packetType)
+{
+  // Save packet type internally to avoid questioning the radio
+  __PacketType = packetType;
+  RegCacheInvalidate( );
+
+  __WriteCommand( RADIO_SET_PACKETTYPE, ( uint8_t* )&packetType, 1 );
+}
+
+RadioPacketTypes_t __GetPacketType(bool returnLocalCopy)
+{
+  RadioPacketTypes_t packetType = PACKET_TYPE_NONE;
+  if ( returnLocalCopy == false )
+  {
+    __ReadCommand( RADIO_GET_PACKETTYPE, ( uint8_t* )&packetType, 1 );
+    if ( __PacketType != packetType )
+    {
+      __PacketType = packetType;
+    }
+  }
+  else
+  {
+    packetType = __PacketType;
+  }
+  return packetType;
+}
+
+/*!
+   \brief Formats the parameters of the SetRfFrequency command
+*/
+void FormatRfFrequency(uint32_t rfFrequency, uint8_t *buf)
+{
+  uint32_t freq = 0;
+
+#if RADIO_INTEGER_FREQUENCY
+  // Both products fit in 64 bits, and only the low 32 bits of the second one
+  // fall below the shift
+  uint64_t high = ( uint64_t )rfFrequency * FREQ_STEP_MULTIPLIER_HIGH;
+  uint64_t low = ( uint64_t )rfFrequency * FREQ_STEP_MULTIPLIER_LOW;
+
+  freq = ( uint32_t )( ( high + ( low >> 32 ) ) >> ( FREQ_STEP_SHIFT - 32 ) );
+#else
+  freq = ( uint32_t )( ( double )rfFrequency / ( double )FREQ_STEP );
+#endif
+  buf[0] = ( uint8_t )( ( freq >> 16 ) & 0xFF );
+  buf[1] = ( uint8_t )( ( freq >> 8 ) & 0xFF );
+  buf[2] = ( uint8_t )( freq & 0xFF );
+}
+
+void __SetRfFrequency(uint32_t rfFrequency)
+{
+  uint8_t buf[3];
+
+  FormatRfFrequency( rfFrequency, buf );
+  __WriteCommand( RADIO_SET_RFFREQUENCY, buf, 3 );
+}
+
+#if RADIO_HOP_CHANNELS > 0
+/*!
+   \brief Tunes the radio to the next channel of the hop sequence
+
+   \param [in]  reference     Time the hop was requested [us]
+   \retval      channel       Index of the new channel
+*/
+uint8_t HopNext(uint32_t reference)
+{
+  uint8_t length = ( __HopSequence != NULL ) ? __HopSequenceLength : __HopChannels;
+  uint8_t channel;
+  uint32_t latency;
+
+  if ( length == 0 )
+  {
+    return 0;
+  }
+  channel = ( __HopSequence != NULL ) ? __HopSequence[__HopPosition] : __HopPosition;
+  if ( ++__HopPosition >= length )
+  {
+    __HopPosition = 0;
+  }
+  if ( channel >= __HopChannels )
+  {
+    return channel;
+  }
+  __WriteCommand( RADIO_SET_RFFREQUENCY, __HopSteps[channel], 3 );
+
+  latency = __Transport->GetTime( ) - reference;
+  __HopStats.Hops++;
+  __HopStats.TotalLatency += latency;
+  if ( latency > __HopStats.MaxLatency )
+  {
+    __HopStats.MaxLatency = latency;
+  }
+  return channel;
+}
+
+/*!
+   \brief Computes the PLL steps of the hop channels, at most
+   RADIO_HOP_CHANNELS, and restarts the hop sequence
+
+   \retval      count         Number of channels kept
+*/
+uint8_t __SetHopChannels(const uint32_t *frequencies, uint8_t count)
+{
+  if ( count > RADIO_HOP_CHANNELS )
+  {
+    count = RADIO_HOP_CHANNELS;
+  }
+  for ( uint8_t i = 0; i < count; i++ )
+  {
+    FormatRfFrequency( frequencies[i], __HopSteps[i] );
+  }
+  __HopChannels = count;
+  __HopPosition = 0;
+  return count;
+}
+
+/*!
+   \brief Sets the order of the channels, as indexes in the table given to
+   SetHopChannels( ), and restarts from its first entry. NULL walks the
+   channels in table order
+
+   \remark The sequence is not copied and must stay valid while in use
+*/
+void __SetHopSequence(const uint8_t *sequence, uint8_t length)
+{
+  __HopSequence = sequence;
+  __HopSequenceLength = length;
+  __HopPosition = 0;
+}
+
+/*!
+   \brief Selects the events on which the engine hops by itself, as an OR of
+   RadioHopTriggers_t. The hop is issued by Poll( ) right after the event is
+   decoded, before the next SetTx or SetRx of the application
+*/
+void __SetHopTrigger(uint8_t triggers)
+{
+  __HopTriggers = triggers;
+}
+
+uint8_t __Hop(void)
+{
+  return HopNext( __Transport->GetTime( ) );
+}
+
+RadioHopStats_t __GetHopStats(void)
+{
+  return __HopStats;
+}
+
+void __ResetHopStats(void)
+{
+  __HopStats.Hops = 0;
+  __HopStats.TotalLatency = 0;
+  __HopStats.MaxLatency = 0;
+}
+#endif
+
+void __SetTxParams(int8_t power, RadioRampTimes_t rampTime)
+{
+  uint8_t buf[2];
+
+  // The power value to send on SPI/UART is in the range [0..31] and the
+  // physical output power is in the range [-18..13]dBm
+  buf[0] = power + 18;
+  buf[1] = ( uint8_t )rampTime;
+  __WriteCommand( RADIO_SET_TXPARAMS, buf, 2 );
+}
+
+void __SetCadParams(RadioLoRaCadSymbols_t cadSymbolNum)
+{
+  __WriteCommand( RADIO_SET_CADPARAMS, ( uint8_t* )&cadSymbolNum, 1 );
+  __OperatingMode = MODE_CAD;
+}
+
+void __SetBufferBaseAddresses(uint8_t txBaseAddress, uint8_t rxBaseAddress)
+{
+  uint8_t buf[2];
+
+  buf[0] = txBaseAddress;
+  buf[1] = rxBaseAddress;
+  __WriteCommand( RADIO_SET_BUFFERBASEADDRESS, buf, 2 );
+  __TxBaseAddress = txBaseAddress;
+  __RxBaseAddress = rxBaseAddress;
+}
+
+/*!
+   \brief Formats the parameters of the SetModulationParams command
+*/
+void FormatModulationParams(const ModulationParams_t *modParams, uint8_t *buf)
+{
+  switch ( modParams->PacketType )
+  {
+#if RADIO_FEATURE_GFSK
+    case PACKET_TYPE_GFSK:
+      buf[0] = modParams->Params.Gfsk.BitrateBandwidth;
+      buf[1] = modParams->Params.Gfsk.ModulationIndex;
+      buf[2] = modParams->Params.Gfsk.ModulationShaping;
+      break;
+#endif
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+      buf[0] = modParams->Params.LoRa.SpreadingFactor;
+      buf[1] = modParams->Params.LoRa.Bandwidth;
+      buf[2] = modParams->Params.LoRa.CodingRate;
+      break;
+#if RADIO_FEATURE_FLRC
+    case PACKET_TYPE_FLRC:
+      buf[0] = modParams->Params.Flrc.BitrateBandwidth;
+      buf[1] = modParams->Params.Flrc.CodingRate;
+      buf[2] = modParams->Params.Flrc.ModulationShaping;
+      break;
+#endif
+#if RADIO_FEATURE_BLE
+    case PACKET_TYPE_BLE:
+      buf[0] = modParams->Params.Ble.BitrateBandwidth;
+      buf[1] = modParams->Params.Ble.ModulationIndex;
+      buf[2] = modParams->Params.Ble.ModulationShaping;
+      break;
+#endif
+    case PACKET_TYPE_NONE:
+    default:
+      buf[0] = 0;
+      buf[1] = 0;
+      buf[2] = 0;
+      break;
+  }
+}
+
+void __SetModulationParams(ModulationParams_t *modParams)
+{
+  uint8_t buf[3];
+
+  // Check if required configuration corresponds to the stored packet type
+  // If not, silently update radio packet type
+  if ( __PacketType != modParams->PacketType )
+  {
+    __SetPacketType( modParams->PacketType );
+  }
+
+  if ( ( modParams->PacketType == PACKET_TYPE_LORA ) || ( modParams->PacketType == PACKET_TYPE_RANGING ) )
+  {
+    __LoRaBandwidth = modParams->Params.LoRa.Bandwidth;
+  }
+  FormatModulationParams( modParams, buf );
+  __WriteCommand( RADIO_SET_MODULATIONPARAMS, buf, 3 );
+}
+
+/*!
+   \brief Formats the parameters of the SetPacketParams command
+*/
+void FormatPacketParams(const PacketParams_t *packetParams, uint8_t *buf)
+{
+  switch ( packetParams->PacketType )
+  {
+#if RADIO_FEATURE_GFSK
+    case PACKET_TYPE_GFSK:
+      buf[0] = packetParams->Params.Gfsk.PreambleLength;
+      buf[1] = packetParams->Params.Gfsk.SyncWordLength;
+      buf[2] = packetParams->Params.Gfsk.SyncWordMatch;
+      buf[3] = packetParams->Params.Gfsk.HeaderType;
+      buf[4] = packetParams->Params.Gfsk.PayloadLength;
+      buf[5] = packetParams->Params.Gfsk.CrcLength;
+      buf[6] = packetParams->Params.Gfsk.Whitening;
+      break;
+#endif
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+      buf[0] = packetParams->Params.LoRa.PreambleLength;
+      buf[1] = packetParams->Params.LoRa.HeaderType;
+      buf[2] = packetParams->Params.LoRa.PayloadLength;
+      buf[3] = packetParams->Params.LoRa.Crc;
+      buf[4] = packetParams->Params.LoRa.InvertIQ;
+      buf[5] = 0;
+      buf[6] = 0;
+      break;
+#if RADIO_FEATURE_FLRC
+    case PACKET_TYPE_FLRC:
+      buf[0] = packetParams->Params.Flrc.PreambleLength;
+      buf[1] = packetParams->Params.Flrc.SyncWordLength;
+      buf[2] = packetParams->Params.Flrc.SyncWordMatch;
+      buf[3] = packetParams->Params.Flrc.HeaderType;
+      buf[4] = packetParams->Params.Flrc.PayloadLength;
+      buf[5] = packetParams->Params.Flrc.CrcLength;
+      buf[6] = packetParams->Params.Flrc.Whitening;
+      break;
+#endif
+#if RADIO_FEATURE_BLE
+    case PACKET_TYPE_BLE:
+      buf[0] = packetParams->Params.Ble.ConnectionState;
+      buf[1] = packetParams->Params.Ble.CrcLength;
+      buf[2] = packetParams->Params.Ble.BleTestPayload;
+      buf[3] = packetParams->Params.Ble.Whitening;
+      buf[4] = 0;
+      buf[5] = 0;
+      buf[6] = 0;
+      break;
+#endif
+    case PACKET_TYPE_NONE:
+    default:
+      buf[0] = 0;
+      buf[1] = 0;
+      buf[2] = 0;
+      buf[3] = 0;
+      buf[4] = 0;
+      buf[5] = 0;
+      buf[6] = 0;
+      break;
+  }
+}
+
+void __SetPacketParams(PacketParams_t *packetParams)
+{
+  uint8_t buf[7];
+  // Check if required configuration corresponds to the stored packet type
+  // If not, silently update radio packet type
+  if ( __PacketType != packetParams->PacketType )
+  {
+    __SetPacketType( packetParams->PacketType );
+  }
+  __PacketParams = *packetParams;
+#if RADIO_TX_QUEUE_SIZE > 0
+  // New parameters of the application, or the saved ones restored
+  __TxQueueLengthSet = false;
+#endif
+
+  if ( ( packetParams->PacketType == PACKET_TYPE_LORA ) || ( packetParams->PacketType == PACKET_TYPE_RANGING ) )
+  {
+    __LoRaHeaderType = packetParams->Params.LoRa.HeaderType;
+    __LoRaPayloadLength = packetParams->Params.LoRa.PayloadLength;
+  }
+  FormatPacketParams( packetParams, buf );
+  __WriteCommand( RADIO_SET_PACKETPARAMS, buf, 7 );
+  // Packet parameters are mirrored in registers such as REG_LR_PACKETPARAMS
+  RegCacheInvalidate( );
+}
+
+void __GetRxBufferStatus(uint8_t *rxPayloadLength, uint8_t *rxStartBufferPointer)
+{
+  uint8_t status[2];
+
+  __ReadCommand( RADIO_GET_RXBUFFERSTATUS, status, 2 );
+
+  // In case of LORA fixed header, the rxPayloadLength is obtained by reading
+  // the register REG_LR_PAYLOADLENGTH
+  if ( ( __GetPacketType( true ) == PACKET_TYPE_LORA ) && ( __ReadRegister_1( REG_LR_PACKETPARAMS ) >> 7 == 1 ) )
+  {
+    *rxPayloadLength = __ReadRegister_1( REG_LR_PAYLOADLENGTH );
+  }
+  else if ( __GetPacketType( true ) == PACKET_TYPE_BLE )
+  {
+    // In the case of BLE, the size returned in status[0] do not include the 2-byte length PDU header
+    // so it is added there
+    *rxPayloadLength = status[0] + 2;
+  }
+  else
+  {
+    *rxPayloadLength = status[0];
+  }
+
+  *rxStartBufferPointer = status[1];
+}
+
+void __GetPacketStatus(PacketStatus_t *packetStatus)
+{
+  uint8_t status[5];
+
+  __ReadCommand( RADIO_GET_PACKETSTATUS, status, 5 );
+
+  packetStatus->packetType = __GetPacketType( true );
+  switch ( packetStatus->packetType )
+  {
+#if RADIO_FEATURE_GFSK
+    case PACKET_TYPE_GFSK:
+      packetStatus->Gfsk.RssiSync = -( status[1] / 2 );
+
+      packetStatus->Gfsk.ErrorStatus.SyncError = ( status[2] >> 6 ) & 0x01;
+      packetStatus->Gfsk.ErrorStatus.LengthError = ( status[2] >> 5 ) & 0x01;
+      packetStatus->Gfsk.ErrorStatus.CrcError = ( status[2] >> 4 ) & 0x01;
+      packetStatus->Gfsk.ErrorStatus.AbortError = ( status[2] >> 3 ) & 0x01;
+      packetStatus->Gfsk.ErrorStatus.HeaderReceived = ( status[2] >> 2 ) & 0x01;
+      packetStatus->Gfsk.ErrorStatus.PacketReceived = ( status[2] >> 1 ) & 0x01;
+      packetStatus->Gfsk.ErrorStatus.PacketControlerBusy = status[2] & 0x01;
+
+      packetStatus->Gfsk.TxRxStatus.RxNoAck = ( status[3] >> 5 ) & 0x01;
+      packetStatus->Gfsk.TxRxStatus.PacketSent = status[3] & 0x01;
+
+      packetStatus->Gfsk.SyncAddrStatus = status[4] & 0x07;
+      break;
+#endif
+
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+      packetStatus->LoRa.RssiPkt = -( status[0] / 2 );
+      ( status[1] < 128 ) ? ( packetStatus->LoRa.SnrPkt = status[1] / 4 ) : ( packetStatus->LoRa.SnrPkt = ( ( status[1] - 256 ) / 4 ) );
+      break;
+
+#if RADIO_FEATURE_FLRC
+    case PACKET_TYPE_FLRC:
+      packetStatus->Flrc.RssiSync = -( status[1] / 2 );
+
+      packetStatus->Flrc.ErrorStatus.SyncError = ( status[2] >> 6 ) & 0x01;
+      packetStatus->Flrc.ErrorStatus.LengthError = ( status[2] >> 5 ) & 0x01;
+      packetStatus->Flrc.ErrorStatus.CrcError = ( status[2] >> 4 ) & 0x01;
+      packetStatus->Flrc.ErrorStatus.AbortError = ( status[2] >> 3 ) & 0x01;
+      packetStatus->Flrc.ErrorStatus.HeaderReceived = ( status[2] >> 2 ) & 0x01;
+      packetStatus->Flrc.ErrorStatus.PacketReceived = ( status[2] >> 1 ) & 0x01;
+      packetStatus->Flrc.ErrorStatus.PacketControlerBusy = status[2] & 0x01;
+
+      packetStatus->Flrc.TxRxStatus.RxPid = ( status[3] >> 6 ) & 0x03;
+      packetStatus->Flrc.TxRxStatus.RxNoAck = ( status[3] >> 5 ) & 0x01;
+      packetStatus->Flrc.TxRxStatus.RxPidErr = ( status[3] >> 4 ) & 0x01;
+      packetStatus->Flrc.TxRxStatus.PacketSent = status[3] & 0x01;
+
+      packetStatus->Flrc.SyncAddrStatus = status[4] & 0x07;
+      break;
+#endif
+
+#if RADIO_FEATURE_BLE
+    case PACKET_TYPE_BLE:
+      packetStatus->Ble.RssiSync =  -( status[1] / 2 );
+
+      packetStatus->Ble.ErrorStatus.SyncError = ( status[2] >> 6 ) & 0x01;
+      packetStatus->Ble.ErrorStatus.LengthError = ( status[2] >> 5 ) & 0x01;
+      packetStatus->Ble.ErrorStatus.CrcError = ( status[2] >> 4 ) & 0x01;
+      packetStatus->Ble.ErrorStatus.AbortError = ( status[2] >> 3 ) & 0x01;
+      packetStatus->Ble.ErrorStatus.HeaderReceived = ( status[2] >> 2 ) & 0x01;
+      packetStatus->Ble.ErrorStatus.PacketReceived = ( status[2] >> 1 ) & 0x01;
+      packetStatus->Ble.ErrorStatus.PacketControlerBusy = status[2] & 0x01;
+
+      packetStatus->Ble.TxRxStatus.PacketSent = status[3] & 0x01;
+
+      packetStatus->Ble.SyncAddrStatus = status[4] & 0x07;
+      break;
+#endif
+
+    case PACKET_TYPE_NONE:
+    default:
+      // In that specific case, we set everything in the packetStatus to zeros
+      // and reset the packet type accordingly
+      memset( packetStatus, 0, sizeof( PacketStatus_t ) );
+      packetStatus->packetType = PACKET_TYPE_NONE;
+      break;
+  }
+}
+
+int8_t __GetRssiInst(void)
+{
+  uint8_t raw = 0;
+
+  __ReadCommand( RADIO_GET_RSSIINST, &raw, 1 );
+
+  return ( int8_t ) ( -raw / 2 );
+}
+
+void __SetDioIrqParams(uint16_t irqMask, uint16_t dio1Mask, uint16_t dio2Mask, uint16_t dio3Mask)
+{
+  uint8_t buf[8];
+
+  buf[0] = ( uint8_t )( ( irqMask >> 8 ) & 0x00FF );
+  buf[1] = ( uint8_t )( irqMask & 0x00FF );
+  buf[2] = ( uint8_t )( ( dio1Mask >> 8 ) & 0x00FF );
+  buf[3] = ( uint8_t )( dio1Mask & 0x00FF );
+  buf[4] = ( uint8_t )( ( dio2Mask >> 8 ) & 0x00FF );
+  buf[5] = ( uint8_t )( dio2Mask & 0x00FF );
+  buf[6] = ( uint8_t )( ( dio3Mask >> 8 ) & 0x00FF );
+  buf[7] = ( uint8_t )( dio3Mask & 0x00FF );
+  __WriteCommand( RADIO_SET_DIOIRQPARAMS, buf, 8 );
+}
+
+#if RADIO_FEATURE_PROFILES
+/*!
+   \brief Formats once the commands of a modem configuration, for any number
+   of later ApplyProfile( )
+
+   \remark The packet parameters must have the packet type of the modulation
+           parameters
+*/
+void __BuildProfile(RadioProfile_t *profile, const RadioProfileParams_t *params)
+{
+  uint8_t *frame;
+
+  profile->Params = *params;
+  for ( uint8_t i = 0; i < RADIO_PROFILE_COMMANDS; i++ )
+  {
+    profile->Commands[RadioProfileCommands[i].Offset] = RadioProfileCommands[i].Opcode;
+  }
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_PACKET_TYPE].Offset + 1];
+  frame[0] = params->ModulationParams.PacketType;
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_MODULATION_PARAMS].Offset + 1];
+  FormatModulationParams( &params->ModulationParams, frame );
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_PACKET_PARAMS].Offset + 1];
+  FormatPacketParams( &params->PacketParams, frame );
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_RF_FREQUENCY].Offset + 1];
+  FormatRfFrequency( params->RfFrequency, frame );
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_BUFFER_BASE_ADDRESS].Offset + 1];
+  frame[0] = params->TxBaseAddress;
+  frame[1] = params->RxBaseAddress;
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_TX_PARAMS].Offset + 1];
+  frame[0] = params->TxPower + 18;
+  frame[1] = ( uint8_t )params->RampTime;
+
+  frame = &profile->Commands[RadioProfileCommands[PROFILE_DIO_IRQ_PARAMS].Offset + 1];
+  frame[0] = ( uint8_t )( ( params->IrqMask >> 8 ) & 0x00FF );
+  frame[1] = ( uint8_t )( params->IrqMask & 0x00FF );
+  frame[2] = ( uint8_t )( ( params->Dio1Mask >> 8 ) & 0x00FF );
+  frame[3] = ( uint8_t )( params->Dio1Mask & 0x00FF );
+  frame[4] = ( uint8_t )( ( params->Dio2Mask >> 8 ) & 0x00FF );
+  frame[5] = ( uint8_t )( params->Dio2Mask & 0x00FF );
+  frame[6] = ( uint8_t )( ( params->Dio3Mask >> 8 ) & 0x00FF );
+  frame[7] = ( uint8_t )( params->Dio3Mask & 0x00FF );
+}
+
+/*!
+   \brief Puts the radio in standby and sends the commands of the profile
+   whose frame differs from the last one sent, by a profile or a Set function
+
+   \retval      count         Number of commands sent, standby included
+*/
+uint8_t __ApplyProfile(const RadioProfile_t *profile)
+{
+  const RadioProfileParams_t *params = &profile->Params;
+  bool packetChanged = false;
+  uint8_t count = 0;
+
+  if ( ( __OperatingMode != MODE_STDBY_RC ) && ( __OperatingMode != MODE_STDBY_XOSC ) )
+  {
+    __SetStandby( STDBY_RC );
+    count++;
+  }
+  for ( uint8_t i = 0; i < RADIO_PROFILE_COMMANDS; i++ )
+  {
+    const RadioProfileCommand_t *command = &RadioProfileCommands[i];
+    const uint8_t *frame = &profile->Commands[command->Offset];
+
+    if ( ( ( __ProfileShadowValid & ( 1 << i ) ) != 0 ) &&
+         ( memcmp( &__ProfileShadow[command->Offset], frame, command->Size + 1 ) == 0 ) )
+    {
+      continue;
+    }
+    __WriteCommand( ( RadioCommands_t )frame[0], ( uint8_t* )&frame[1], command->Size );
+    if ( ( i == PROFILE_PACKET_TYPE ) || ( i == PROFILE_PACKET_PARAMS ) )
+    {
+      packetChanged = true;
+    }
+    count++;
+  }
+
+  // Local copies otherwise kept by the Set functions
+  __PacketType = params->ModulationParams.PacketType;
+  __PacketParams = params->PacketParams;
+#if RADIO_TX_QUEUE_SIZE > 0
+  __TxQueueLengthSet = false;
+#endif
+  if ( ( __PacketType == PACKET_TYPE_LORA ) || ( __PacketType == PACKET_TYPE_RANGING ) )
+  {
+    __LoRaBandwidth = params->ModulationParams.Params.LoRa.Bandwidth;
+    __LoRaHeaderType = params->PacketParams.Params.LoRa.HeaderType;
+    __LoRaPayloadLength = params->PacketParams.Params.LoRa.PayloadLength;
+  }
+  __TxBaseAddress = params->TxBaseAddress;
+  __RxBaseAddress = params->RxBaseAddress;
+  if ( packetChanged == true )
+  {
+    RegCacheInvalidate( );
+  }
+  return count;
+}
+#endif
+
+uint16_t __GetIrqStatus(void)
+{
+  uint8_t irqStatus[2];
+  __ReadCommand( RADIO_GET_IRQSTATUS, irqStatus, 2 );
+  return ( irqStatus[0] << 8 ) | irqStatus[1];
+}
+
+void __ClearIrqStatus(uint16_t irqMask)
+{
+  uint8_t buf[2];
+
+  buf[0] = ( uint8_t )( ( ( uint16_t )irqMask >> 8 ) & 0x00FF );
+  buf[1] = ( uint8_t )( ( uint16_t )irqMask & 0x00FF );
+  __WriteCommand( RADIO_CLR_IRQSTATUS, buf, 2 );
+}
+
+void __Calibrate(CalibrationParams_t calibParam)
+{
+  uint8_t cal = ( calibParam.ADCBulkPEnable << 5 ) |
+                ( calibParam.ADCBulkNEnable << 4 ) |
+                ( calibParam.ADCPulseEnable << 3 ) |
+                ( calibParam.PLLEnable << 2 ) |
+                ( calibParam.RC13MEnable << 1 ) |
+                ( calibParam.RC64KEnable );
+  __WriteCommand( RADIO_CALIBRATE, &cal, 1 );
+}
+
+void __SetRegulatorMode(RadioRegulatorModes_t mode)
+{
+  __WriteCommand( RADIO_SET_REGULATORMODE, ( uint8_t* )&mode, 1 );
+}
+
+void __SetSaveContext(void)
+{
+  __WriteCommand( RADIO_SET_SAVECONTEXT, 0, 0 );
+}
+
+void __SetAutoTx(uint16_t time)
+{
+  uint16_t compensatedTime = time - ( uint16_t )AUTO_TX_OFFSET;
+  uint8_t buf[2];
+
+  buf[0] = ( uint8_t )( ( compensatedTime >> 8 ) & 0x00FF );
+  buf[1] = ( uint8_t )( compensatedTime & 0x00FF );
+  __WriteCommand( RADIO_SET_AUTOTX, buf, 2 );
+}
+
+void __SetAutoFs(bool enableAutoFs)
+{
+  __WriteCommand( RADIO_SET_AUTOFS, ( uint8_t * )&enableAutoFs, 1 );
+}
+
+void __SetLongPreamble(bool enable)
+{
+  __WriteCommand( RADIO_SET_LONGPREAMBLE, ( uint8_t * )&enable, 1 );
+}
+
+void __SetPayload(uint8_t *buffer, uint8_t size, uint8_t offset)
+{
+  __WriteBuffer( offset, buffer, size );
+}
+
+uint8_t __GetPayload(uint8_t *buffer, uint8_t *size , uint8_t maxSize)
+{
+  uint8_t offset;
+
+  __GetRxBufferStatus( size, &offset );
+  if ( *size > maxSize )
+  {
+    return 1;
+  }
+  __ReadBuffer( offset, buffer, *size );
+  return 0;
+}
+
+uint8_t __ReadRxFrame(RadioRxFrame_t *frame, uint8_t *payload, uint8_t maxSize)
+{
+  uint8_t status[2];
+  uint8_t result = 0;
+
+  frame->IrqStatus = __GetIrqStatus( );
+  __ReadCommand( RADIO_GET_RXBUFFERSTATUS, status, 2 );
+
+  // Same rules as GetRxBufferStatus( ), but the LoRa header mode and fixed
+  // length come from the local copy of the packet parameters instead of
+  // two more register reads
+  if ( ( __PacketType == PACKET_TYPE_LORA ) && ( __LoRaHeaderType == LORA_PACKET_FIXED_LENGTH ) )
+  {
+    frame->Size = __LoRaPayloadLength;
+  }
+  else if ( __PacketType == PACKET_TYPE_BLE )
+  {
+    frame->Size = status[0] + 2;
+  }
+  else
+  {
+    frame->Size = status[0];
+  }
+
+  if ( frame->Size > maxSize )
+  {
+    result = 1;
+  }
+  else
+  {
+    __ReadBuffer( status[1], payload, frame->Size );
+  }
+  __GetPacketStatus( &frame->PacketStatus );
+  // No transaction outside LoRa and ranging
+  frame->FrequencyError = __GetFrequencyError( );
+  return result;
+}
+
+void __SendPayload(uint8_t *payload, uint8_t size, TickTime_t timeout, uint8_t offset)
+{
+  __SetPayload( payload, size, offset );
+  __SetTx( timeout );
+}
+
+#if RADIO_TX_QUEUE_SIZE > 0
+/*!
+   \brief Sets the payload length of the packet parameters to the size of
+   the next frame, with a transaction only when it changes. The length of
+   the application is saved for TxQueueRestoreLength( )
+*/
+void TxQueueSetLength(uint8_t size)
+{
+  PacketParams_t packetParams = __PacketParams;
+  uint8_t *length = PacketParamsLength( &packetParams );
+  uint8_t savedLength;
+
+  if ( ( length == NULL ) || ( *length == size ) )
+  {
+    return;
+  }
+  savedLength = ( __TxQueueLengthSet == true ) ? __TxQueueSavedLength : *length;
+  *length = size;
+  __SetPacketParams( &packetParams );
+  __TxQueueSavedLength = savedLength;
+  __TxQueueLengthSet = true;
+}
+
+/*!
+   \brief Writes the frame following the one on air in the other half of the
+   data buffer, when both fit in a half
+*/
+void TxQueuePreload(void)
+{
+  RadioTxFrame_t *current = &__TxQueue[__TxQueueTail & ( RADIO_TX_QUEUE_SIZE - 1 )];
+  RadioTxFrame_t *next = &__TxQueue[( __TxQueueTail + 1 ) & ( RADIO_TX_QUEUE_SIZE - 1 )];
+
+  if ( ( __TxDoubleBuffer == false ) || ( __TxQueueBusy == false ) || ( __TxQueuePreloaded == true ) )
+  {
+    return;
+  }
+  if ( ( uint8_t )( __TxQueueHead - __TxQueueTail ) < 2 )
+  {
+    return;
+  }
+  if ( ( current->Size > RADIO_TX_BUFFER_HALF ) || ( next->Size > RADIO_TX_BUFFER_HALF ) )
+  {
+    return;
+  }
+  __SetPayload( next->Payload, next->Size, __TxBaseAddress ^ RADIO_TX_BUFFER_HALF );
+  __TxQueuePreloaded = true;
+}
+
+/*!
+   \brief Loads the frame at the tail of the TX queue, unless it was
+   preloaded, and starts its transmission
+*/
+void TxQueueStart(void)
+{
+  RadioTxFrame_t *frame = &__TxQueue[__TxQueueTail & ( RADIO_TX_QUEUE_SIZE - 1 )];
+
+  if ( __TxQueuePreloaded == true )
+  {
+    // The payload is already in the other half, only the base moves
+    __SetBufferBaseAddresses( __TxBaseAddress ^ RADIO_TX_BUFFER_HALF, __RxBaseAddress );
+    __TxQueuePreloaded = false;
+    __TxQueueStats.Preloaded++;
+  }
+  else
+  {
+    __SetPayload( frame->Payload, frame->Size, __TxBaseAddress );
+  }
+  TxQueueSetLength( frame->Size );
+  __TxQueueLatency = __Transport->GetTime( ) - frame->EnqueueTime;
+  __SetTx( frame->Timeout );
+  __TxQueueBusy = true;
+  TxQueuePreload( );
+}
+
+/*!
+   \brief Retires the frame whose transmission ended and starts the next
+   one, run on TX done and TX timeout right after the event is queued
+*/
+void TxQueueNext(void)
+{
+  if ( __TxQueueBusy == false )
+  {
+    return;
+  }
+  __TxQueueBusy = false;
+  __TxQueueTail++;
+  __TxQueueStats.Frames++;
+  __TxQueueStats.TotalLatency += __TxQueueLatency;
+  if ( __TxQueueLatency > __TxQueueStats.MaxLatency )
+  {
+    __TxQueueStats.MaxLatency = __TxQueueLatency;
+  }
+  if ( __TxQueueTail != __TxQueueHead )
+  {
+    TxQueueStart( );
+  }
+  else
+  {
+    TxQueueRestoreLength( );
+  }
+}
+
+/*!
+   \brief Queues a frame for transmission, it starts at once when the queue
+   is idle and otherwise on the TX done or TX timeout of the previous frame,
+   decoded by Poll( ) or Dispatch( )
+
+   \remark The payload is not copied and must stay unchanged until the TX
+           done or TX timeout event of the frame
+   \remark The payload length of the packet parameters follows the queued
+           frames, the one set by the application is restored when the
+           queue empties and before SetRx( ) or SetRxDutyCycle( )
+*/
+bool __EnqueuePayload(uint8_t *payload, uint8_t size, TickTime_t timeout)
+{
+  RadioTxFrame_t *frame;
+
+  if ( ( uint8_t )( __TxQueueHead - __TxQueueTail ) >= RADIO_TX_QUEUE_SIZE )
+  {
+    return false;
+  }
+  frame = &__TxQueue[__TxQueueHead & ( RADIO_TX_QUEUE_SIZE - 1 )];
+  frame->Payload = payload;
+  frame->Size = size;
+  frame->Timeout = timeout;
+  frame->EnqueueTime = __Transport->GetTime( );
+  __TxQueueHead++;
+  if ( __TxQueueBusy == false )
+  {
+    TxQueueStart( );
+  }
+  else
+  {
+    TxQueuePreload( );
+  }
+  return true;
+}
+
+uint8_t __GetTxQueueCount(void)
+{
+  return ( uint8_t )( __TxQueueHead - __TxQueueTail );
+}
+
+RadioTxQueueStats_t __GetTxQueueStats(void)
+{
+  return __TxQueueStats;
+}
+
+void __ResetTxQueueStats(void)
+{
+  __TxQueueStats.Frames = 0;
+  __TxQueueStats.TotalLatency = 0;
+  __TxQueueStats.MaxLatency = 0;
+  __TxQueueStats.Preloaded = 0;
+}
+
+/*!
+   \brief Enables the double buffer mode of the TX queue: while a frame is
+   on air the next one is written in the other half of the data buffer, so
+   that on TX done it starts with a base address update and SetTx only
+
+   \remark Both frames must fit in 128 bytes, larger ones are loaded on TX
+           done as without the mode. The whole data buffer is used for TX,
+           a packet received meanwhile may overwrite a preloaded frame
+*/
+void __SetTxDoubleBuffer(bool enable)
+{
+  __TxDoubleBuffer = enable;
+  TxQueuePreload( );
+}
+#endif
+
+#if RADIO_FEATURE_SYNC_WORD
+uint8_t __SetSyncWord(uint8_t syncWordIdx, uint8_t *syncWord)
+{
+  uint16_t addr;
+  uint8_t syncwordSize = 0;
+
+  switch ( __GetPacketType( true ) )
+  {
+#if RADIO_FEATURE_GFSK
+    case PACKET_TYPE_GFSK:
+      syncwordSize = 5;
+      switch ( syncWordIdx )
+      {
+        case 1:
+          addr = REG_LR_SYNCWORDBASEADDRESS1;
+          break;
+        case 2:
+          addr = REG_LR_SYNCWORDBASEADDRESS2;
+          break;
+        case 3:
+          addr = REG_LR_SYNCWORDBASEADDRESS3;
+          break;
+        default:
+          return 1;
+      }
+      break;
+#endif
+#if RADIO_FEATURE_FLRC
+    case PACKET_TYPE_FLRC:
+      // For FLRC packet type, the SyncWord is one byte shorter and
+      // the base address is shifted by one byte
+      syncwordSize = 4;
+      switch ( syncWordIdx )
+      {
+        case 1:
+          addr = REG_LR_SYNCWORDBASEADDRESS1 + 1;
+          break;
+        case 2:
+          addr = REG_LR_SYNCWORDBASEADDRESS2 + 1;
+          break;
+        case 3:
+          addr = REG_LR_SYNCWORDBASEADDRESS3 + 1;
+          break;
+        default:
+          return 1;
+      }
+      break;
+#endif
+#if RADIO_FEATURE_BLE
+    case PACKET_TYPE_BLE:
+      // For Ble packet type, only the first SyncWord is used and its
+      // address is shifted by one byte
+      syncwordSize = 4;
+      switch ( syncWordIdx )
+      {
+        case 1:
+          addr = REG_LR_SYNCWORDBASEADDRESS1 + 1;
+          break;
+        default:
+          return 1;
+      }
+      break;
+#endif
+    default:
+      return 1;
+  }
+  __WriteRegister( addr, syncWord, syncwordSize );
+  return 0;
+}
+
+void __SetSyncWordErrorTolerance(uint8_t errorBits)
+{
+  errorBits = ( __ReadRegister_1( REG_LR_SYNCWORDTOLERANCE ) & 0xF0 ) | ( errorBits & 0x0F );
+  __WriteRegister_1( REG_LR_SYNCWORDTOLERANCE, errorBits );
+}
+
+uint8_t __SetCrcSeed(uint8_t *seed)
+{
+  uint8_t updated = 0;
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_GFSK:
+    case PACKET_TYPE_FLRC:
+      __WriteRegister( REG_LR_CRCSEEDBASEADDR, seed, 2 );
+      updated = 1;
+      break;
+#if RADIO_FEATURE_BLE
+    case PACKET_TYPE_BLE:
+      __WriteRegister_1(0x9c7, seed[2] );
+      __WriteRegister_1(0x9c8, seed[1] );
+      __WriteRegister_1(0x9c9, seed[0] );
+      updated = 1;
+      break;
+#endif
+    default:
+      break;
+  }
+  return updated;
+}
+
+#if RADIO_FEATURE_BLE
+void __SetBleAccessAddress(uint32_t accessAddress)
+{
+  __WriteRegister_1( REG_LR_BLE_ACCESS_ADDRESS, ( accessAddress >> 24 ) & 0x000000FF );
+  __WriteRegister_1( REG_LR_BLE_ACCESS_ADDRESS + 1, ( accessAddress >> 16 ) & 0x000000FF );
+  __WriteRegister_1( REG_LR_BLE_ACCESS_ADDRESS + 2, ( accessAddress >> 8 ) & 0x000000FF );
+  __WriteRegister_1( REG_LR_BLE_ACCESS_ADDRESS + 3, accessAddress & 0x000000FF );
+}
+
+void __SetBleAdvertizerAccessAddress(void)
+{
+  __SetBleAccessAddress( BLE_ADVERTIZER_ACCESS_ADDRESS );
+}
+#endif
+
+void __SetCrcPolynomial(uint16_t polynomial)
+{
+  uint8_t val[2];
+
+  val[0] = ( uint8_t )( polynomial >> 8 ) & 0xFF;
+  val[1] = ( uint8_t )( polynomial  & 0xFF );
+
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_GFSK:
+    case PACKET_TYPE_FLRC:
+      __WriteRegister( REG_LR_CRCPOLYBASEADDR, val, 2 );
+      break;
+    default:
+      break;
+  }
+}
+
+void __SetWhiteningSeed(uint8_t seed)
+{
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_GFSK:
+    case PACKET_TYPE_FLRC:
+    case PACKET_TYPE_BLE:
+      __WriteRegister_1( REG_LR_WHITSEEDBASEADDR, seed );
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if RADIO_FEATURE_RANGING
+void __SetRangingIdLength(RadioRangingIdCheckLengths_t length)
+{
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_RANGING:
+      __WriteRegister_1( REG_LR_RANGINGIDCHECKLENGTH, ( ( ( ( uint8_t )length ) & 0x03 ) << 6 ) | ( __ReadRegister_1( REG_LR_RANGINGIDCHECKLENGTH ) & 0x3F ) );
+      break;
+    default:
+      break;
+  }
+}
+
+void __SetDeviceRangingAddress(uint32_t address)
+{
+  uint8_t addrArray[] = { ( uint8_t )( address >> 24 ), ( uint8_t )( address >> 16 ), ( uint8_t )( address >> 8 ), ( uint8_t )address };
+
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_RANGING:
+      __WriteRegister( REG_LR_DEVICERANGINGADDR, addrArray, 4 );
+      break;
+    default:
+      break;
+  }
+}
+
+void __SetRangingRequestAddress(uint32_t address)
+{
+  uint8_t addrArray[] = { ( uint8_t )( address >> 24 ), ( uint8_t )( address >> 16 ), ( uint8_t )( address >> 8 ), ( uint8_t )address };
+
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_RANGING:
+      __WriteRegister( REG_LR_REQUESTRANGINGADDR, addrArray, 4 );
+      break;
+    default:
+      break;
+  }
+}
+
+#endif
+
+int32_t complement2( const uint32_t num, const uint8_t bitCnt )
+{
+  int32_t retVal = ( int32_t )num;
+  if ( num >= ( uint32_t )2 << ( bitCnt - 2 ) )
+  {
+    retVal -= ( uint32_t )2 << ( bitCnt - 1 );
+  }
+  return retVal;
+}
+
+int32_t __GetLoRaBandwidth( )
+{
+  int32_t bwValue = 0;
+
+  switch ( __LoRaBandwidth )
+  {
+    case LORA_BW_0200:
+      bwValue = 203125;
+      break;
+    case LORA_BW_0400:
+      bwValue = 406250;
+      break;
+    case LORA_BW_0800:
+      bwValue = 812500;
+      break;
+    case LORA_BW_1600:
+      bwValue = 1625000;
+      break;
+    default:
+      bwValue = 0;
+  }
+  return bwValue;
+}
+
+#if RADIO_FEATURE_RANGING
+/*!
+   \brief Conversion of the raw ranging result to Q24.8 meters. The distance
+   is register * 150 / ( 2^12 * bandwidth[MHz] ), and with the bandwidth
+   written 203125 * 2^k Hz this is register * 600 / 13 / 2^k in Q24.8,
+   computed as ( register * RANGING_RAW_MULTIPLIER ) >> ( RANGING_RAW_SHIFT + k )
+*/
+#define RANGING_RAW_MULTIPLIER                      774333046LL // round( 600 / 13 * 2^24 )
+#define RANGING_RAW_SHIFT                           24
+
+/*!
+   \brief Range of the distances, in Q24.8 meters, the short range correction
+   applies to. The fit holds up to 50 m, and a result below -128 m does not
+   come from a real exchange
+*/
+#define RANGING_CORRECTION_MAX                      ( 50 * 256 )
+#define RANGING_CORRECTION_MIN                      ( -128 * 256 )
+
+/*!
+   \brief Short range correction coefficients in Q27.36, the distance d in
+   meters and the RSSI r in dBm giving
+   t0 + t1 * r + t2 * r^2 + t3 * r^3 + t4 * d + t5 * d^2 + t6 * d^3 + t7 * d^4
+*/
+static const int64_t RangingCorrection[8] = {
+  -1129253959LL,                                          // t0 = -0.016432807883697
+  22206492966LL,                                          // t1 = 0.323147003165358
+  1025436248LL,                                           // t2 = 0.014922061351196
+  9471743LL,                                              // t3 = 0.000137832006285
+  36893690501LL,                                          // t4 = 0.536873856625399
+  2809945532LL,                                           // t5 = 0.040890089178579
+  -73859766LL,                                            // t6 = -0.001074801048732
+  634978LL,                                               // t7 = 0.000009240142234
+};
+
+int32_t RangingRawToQ8(int32_t raw)
+{
+  uint8_t shift;
+
+  switch ( __LoRaBandwidth )
+  {
+    case LORA_BW_0200:
+      shift = RANGING_RAW_SHIFT;
+      break;
+    case LORA_BW_0400:
+      shift = RANGING_RAW_SHIFT + 1;
+      break;
+    case LORA_BW_0800:
+      shift = RANGING_RAW_SHIFT + 2;
+      break;
+    case LORA_BW_1600:
+      shift = RANGING_RAW_SHIFT + 3;
+      break;
+    default:
+      return 0;
+  }
+  return ( int32_t )( ( ( int64_t )raw * RANGING_RAW_MULTIPLIER + ( ( int64_t )1 << ( shift - 1 ) ) ) >> shift );
+}
+
+/*!
+   \brief Applies the short range correction to a distance, evaluated with
+   Horner's scheme on 64-bit integers. Distances outside
+   [ RANGING_CORRECTION_MIN, RANGING_CORRECTION_MAX ] are returned unchanged
+
+   \param [in]  distance      Distance in Q24.8 meters
+   \param [in]  rssi          RSSI of the exchange [dBm]
+   \retval      distance      Corrected distance in Q24.8 meters
+*/
+int32_t __RangingShortRangeCorrection(int32_t distance, int8_t rssi)
+{
+  int64_t acc;
+  int64_t sum;
+
+  if ( ( distance > RANGING_CORRECTION_MAX ) || ( distance < RANGING_CORRECTION_MIN ) )
+  {
+    return distance;
+  }
+
+  // Distance terms, the distance being in Q24.8 every product is shifted
+  // back to Q27.36
+  acc = RangingCorrection[7];
+  acc = ( ( acc * distance ) >> 8 ) + RangingCorrection[6];
+  acc = ( ( acc * distance ) >> 8 ) + RangingCorrection[5];
+  acc = ( ( acc * distance ) >> 8 ) + RangingCorrection[4];
+  sum = ( acc * distance ) >> 8;
+
+  // RSSI terms, the RSSI being an integer
+  acc = RangingCorrection[3];
+  acc = acc * rssi + RangingCorrection[2];
+  acc = acc * rssi + RangingCorrection[1];
+  acc = acc * rssi + RangingCorrection[0];
+  sum += acc;
+
+  return ( int32_t )( ( sum + ( ( int64_t )1 << 27 ) ) >> 28 );
+}
+
+/*!
+   \brief Reads the ranging result register and converts it with integers
+   only, without the short range correction
+
+   \retval      distance      Distance in Q24.8 meters (1/256 m)
+*/
+int32_t RangingReadQ8(RadioRangingResultTypes_t resultType)
+{
+  uint32_t valLsb = 0;
+  int32_t val = 0;
+
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_RANGING:
+      __SetStandby( STDBY_XOSC );
+      __WriteRegister_1( 0x97F, __ReadRegister_1( 0x97F ) | ( 1 << 1 ) ); // enable LORA modem clock
+      __WriteRegister_1( REG_LR_RANGINGRESULTCONFIG, ( __ReadRegister_1( REG_LR_RANGINGRESULTCONFIG ) & MASK_RANGINGMUXSEL ) | ( ( ( ( uint8_t )resultType ) & 0x03 ) << 4 ) );
+      valLsb = __ReadRegisterRange( REG_LR_RANGINGRESULTBASEADDR, 3 );
+      __SetStandby( STDBY_RC );
+      RADIO_TRACE( "Raw ranging value : ", complement2( valLsb, 24 ) );
+
+      // Convertion from LSB to distance. For explanation on the formula, refer to Datasheet of SX1280
+      switch ( resultType )
+      {
+        case RANGING_RESULT_RAW:
+          // distance [m] = ( complement2( register ) * 150 ) / ( 2^12 * bandwidth[MHz] ) )
+          val = RangingRawToQ8( complement2( valLsb, 24 ) );
+          RADIO_TRACE( "After conversion using RAW result ranging value (1/256 m): ", val );
+          break;
+
+        case RANGING_RESULT_AVERAGED:
+        case RANGING_RESULT_DEBIASED:
+        case RANGING_RESULT_FILTERED:
+          // distance [m] = register * 20 / 100, rounded to 1/256 m
+          val = ( int32_t )( ( ( valLsb << 8 ) + 2 ) / 5 );
+          RADIO_TRACE( "After conversion using Filtered result ranging value (1/256 m): ", val );
+          break;
+        default:
+          val = 0;
+      }
+      break;
+    default:
+      break;
+  }
+  return val;
+}
+
+/*!
+   \brief Reads the ranging result and converts it with integers only
+
+   \retval      distance      Distance in Q24.8 meters (1/256 m)
+*/
+int32_t __GetRangingResultQ8(RadioRangingResultTypes_t resultType)
+{
+  int32_t val = RangingReadQ8( resultType );
+
+#if RADIO_RANGING_SHORT_RANGE_CORRECTION
+  RADIO_TRACE( "Before Short range correction (1/256 m): ", val );
+  if ( val <= RANGING_CORRECTION_MAX )
+  {
+    val = __RangingShortRangeCorrection( val, __GetRssiInst( ) );
+    RADIO_TRACE( "After Short range correction (1/256 m): ", val );
+  }
+#endif
+  return val;
+}
+
+double __GetRangingResult(RadioRangingResultTypes_t resultType)
+{
+  return ( double )__GetRangingResultQ8( resultType ) / 256.0;
+}
+
+void __SetRangingCalibration(uint16_t cal)
+{
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_RANGING:
+      __WriteRegister_1( REG_LR_RANGINGRERXTXDELAYCAL, ( uint8_t )( ( cal >> 8 ) & 0xFF ) );
+      __WriteRegister_1( REG_LR_RANGINGRERXTXDELAYCAL + 1, ( uint8_t )( ( cal ) & 0xFF ) );
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+   \brief Sets the calibration and the frequency error gradient of a
+   bandwidth and spreading factor from RangingCalibration.h
+
+   \retval      calibrated    false, with nothing changed, for BW 200 kHz and SF11/SF12
+*/
+bool __SetRangingProfile(RadioLoRaBandwidths_t bandwidth, RadioLoRaSpreadingFactors_t spreadingFactor)
+{
+  uint8_t row = RangingCalibrationRow( bandwidth );
+  uint8_t column = RangingCalibrationColumn( spreadingFactor );
+
+  if ( ( row >= RANGING_CALIBRATION_BW_COUNT ) || ( column >= RANGING_CALIBRATION_SF_COUNT ) )
+  {
+    return false;
+  }
+  __SetRangingCalibration( RangingCalibrations[row][column] );
+  __RangingFeiGradient = RangingFeiGradients[row][column];
+  return true;
+}
+
+int16_t __GetRangingFeiGradient(void)
+{
+  return __RangingFeiGradient;
+}
+
+/*!
+   \brief Frequency error of the last LoRa or ranging reception with integers
+   only. The error is 1.55 * register / ( 1.6 / bandwidth[MHz] ), and with the
+   bandwidth written 203125 * 2^k Hz this is register * 403 / 2^( 11 - k )
+
+   \retval      fei           Frequency error [Hz], 0 for an unknown bandwidth
+*/
+int32_t FrequencyErrorHz(void)
+{
+  uint32_t efe = __ReadRegisterRange( REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB, 3 ) & REG_LR_ESTIMATED_FREQUENCY_ERROR_MASK;
+  uint8_t shift;
+
+  switch ( __LoRaBandwidth )
+  {
+    case LORA_BW_0200:
+      shift = 11;
+      break;
+    case LORA_BW_0400:
+      shift = 10;
+      break;
+    case LORA_BW_0800:
+      shift = 9;
+      break;
+    case LORA_BW_1600:
+      shift = 8;
+      break;
+    default:
+      return 0;
+  }
+  return ( complement2( efe, 20 ) * 403 + ( 1 << ( shift - 1 ) ) ) >> shift;
+}
+
+/*!
+   \brief Reads the ranging result with the frequency error and the RSSI of
+   the exchange. Raw keeps the register distance; Corrected applies the
+   frequency error gradient set by SetRangingProfile( ), then the short range
+   correction when it is enabled, in the order of the DevKit demo.
+
+   The gradients of RangingCalibration.h apply to the frequency error the
+   slave measures on the master's request, which the DevKit demo relays and
+   subtracts times the gradient. The master reads the opposite error on the
+   response, so the correction is added here. With the gradient in mm/kHz
+   and the error in Hz, it is gradient * error * 256 / 10^6 in Q24.8,
+   computed as ( gradient * error * RANGING_FEI_MULTIPLIER ) >> RANGING_FEI_SHIFT
+
+   To be read right after the exchange, before the radio receives again:
+   the frequency error and RSSI registers belong to the last reception.
+*/
+#define RANGING_FEI_MULTIPLIER                      1099512LL   // round( 256 / 10^6 * 2^32 )
+#define RANGING_FEI_SHIFT                           32
+
+RadioRangingResult_t __GetCompensatedRangingResult(RadioRangingResultTypes_t resultType)
+{
+  RadioRangingResult_t result;
+
+  // RSSI and frequency error first, reading the ranging result leaves the receiver
+  result.Rssi = __GetRssiInst( );
+  result.Fei = FrequencyErrorHz( );
+  result.Raw = RangingReadQ8( resultType );
+  result.Corrected = result.Raw + ( int32_t )( ( ( int64_t )__RangingFeiGradient * result.Fei * RANGING_FEI_MULTIPLIER +
+                                                 ( ( int64_t )1 << ( RANGING_FEI_SHIFT - 1 ) ) ) >> RANGING_FEI_SHIFT );
+#if RADIO_RANGING_SHORT_RANGE_CORRECTION
+  if ( result.Corrected <= RANGING_CORRECTION_MAX )
+  {
+    result.Corrected = __RangingShortRangeCorrection( result.Corrected, result.Rssi );
+  }
+#endif
+  RADIO_TRACE( "Frequency error compensated ranging value (1/256 m): ", result.Corrected );
+  return result;
+}
+
+void __RangingClearFilterResult(void)
+{
+  uint8_t regVal = __ReadRegister_1( REG_LR_RANGINGRESULTCLEARREG );
+
+  // To clear result, set bit 5 to 1 then to 0
+  __WriteRegister_1( REG_LR_RANGINGRESULTCLEARREG, regVal | ( 1 << 5 ) );
+  __WriteRegister_1( REG_LR_RANGINGRESULTCLEARREG, regVal & ( ~( 1 << 5 ) ) );
+}
+
+void __RangingSetFilterNumSamples(uint8_t num)
+{
+  // Silently set 8 as minimum value
+  __WriteRegister_1( REG_LR_RANGINGFILTERWINDOWSIZE, ( num < DEFAULT_RANGING_FILTER_SIZE ) ? DEFAULT_RANGING_FILTER_SIZE : num );
+}
+
+#if RADIO_RANGING_STATS_SIZE > 0
+/*!
+   \brief Samples are saturated to +/- 16384 m, beyond the reach of the
+   radio, which keeps the Welford products within 64 bits
+*/
+#define RANGING_STATS_LIMIT                         ( ( int32_t )16384 * 256 )
+
+/*!
+   \brief Index of the first sample greater than distance, or greater or
+   equal when inclusive is false
+*/
+uint8_t RangingStatsBound(const RadioRangingStats_t *stats, int64_t distance, bool inclusive)
+{
+  uint8_t low = 0;
+  uint8_t high = stats->Count;
+
+  while ( low < high )
+  {
+    uint8_t middle = ( low + high ) / 2;
+
+    if ( ( stats->Samples[middle] < distance ) || ( inclusive && ( stats->Samples[middle] == distance ) ) )
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+uint32_t RangingStatsSqrt(uint64_t value)
+{
+  uint64_t root = 0;
+  uint64_t bit = ( uint64_t )1 << 62;
+
+  while ( bit > value )
+  {
+    bit >>= 2;
+  }
+  while ( bit != 0 )
+  {
+    if ( value >= root + bit )
+    {
+      value -= root + bit;
+      root = ( root >> 1 ) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return ( uint32_t )root;
+}
+
+void __RangingStatsReset(RadioRangingStats_t *stats)
+{
+  stats->Count = 0;
+  stats->RssiSum = 0;
+  stats->Mean = 0;
+  stats->M2 = 0;
+}
+
+/*!
+   \brief Adds a ranging sample, in O( log n ) comparisons plus the move of
+   the greater samples. The RSSI weight grows linearly with the RSSI in dB,
+   from 1 at -128 dBm
+
+   \param [in]  stats         Statistics to update
+   \param [in]  distance      Distance in Q24.8 meters
+   \param [in]  rssi          RSSI of the exchange [dBm]
+   \retval      added         false when the statistics are full
+*/
+bool __RangingStatsAdd(RadioRangingStats_t *stats, int32_t distance, int8_t rssi)
+{
+  uint8_t index;
+  int64_t delta;
+
+  if ( stats->Count >= RADIO_RANGING_STATS_SIZE )
+  {
+    return false;
+  }
+  if ( distance > RANGING_STATS_LIMIT )
+  {
+    distance = RANGING_STATS_LIMIT;
+  }
+  else if ( distance < -RANGING_STATS_LIMIT )
+  {
+    distance = -RANGING_STATS_LIMIT;
+  }
+
+  index = RangingStatsBound( stats, distance, true );
+  memmove( &stats->Samples[index + 1], &stats->Samples[index], ( stats->Count - index ) * sizeof( stats->Samples[0] ) );
+  memmove( &stats->Weights[index + 1], &stats->Weights[index], stats->Count - index );
+  stats->Samples[index] = distance;
+  stats->Weights[index] = ( rssi > -128 ) ? ( uint8_t )( rssi + 128 ) : 1;
+  stats->Count++;
+  stats->RssiSum += rssi;
+
+  delta = ( ( int64_t )distance << 8 ) - stats->Mean;
+  stats->Mean += delta / stats->Count;
+  stats->M2 += ( delta * ( ( ( int64_t )distance << 8 ) - stats->Mean ) ) >> 16;
+  return true;
+}
+
+/*!
+   \brief Aggregates the samples. The z-score window starts at
+   RADIO_RANGING_ZSCORE_MIN standard deviations and widens up to
+   RADIO_RANGING_ZSCORE_MAX until minAccepted samples fall inside. The
+   samples being sorted, the window is found with two binary searches
+
+   \param [in]  stats         Statistics to aggregate
+   \param [in]  minAccepted   Number of accepted samples for a valid result
+   \param [out] result        Aggregated result
+   \retval      valid         true when at least minAccepted samples are accepted
+*/
+bool __RangingStatsGetResult(const RadioRangingStats_t *stats, uint8_t minAccepted, RadioRangingStatsResult_t *result)
+{
+  uint8_t first = 0;
+  uint8_t last = 0;
+  int64_t weightedSum = 0;
+  uint32_t weightSum = 0;
+
+  memset( result, 0, sizeof( RadioRangingStatsResult_t ) );
+  result->Count = stats->Count;
+  if ( stats->Count == 0 )
+  {
+    return false;
+  }
+  result->Mean = ( int32_t )( ( stats->Mean + 128 ) >> 8 );
+  result->StdDev = ( int32_t )RangingStatsSqrt( ( uint64_t )( stats->M2 / stats->Count ) );
+  result->Rssi = ( int8_t )( stats->RssiSum / stats->Count );
+
+  for ( uint8_t z = RADIO_RANGING_ZSCORE_MIN; z <= RADIO_RANGING_ZSCORE_MAX; z++ )
+  {
+    int64_t spread = ( int64_t )z * result->StdDev;
+
+    first = RangingStatsBound( stats, ( int64_t )result->Mean - spread, false );
+    last = RangingStatsBound( stats, ( int64_t )result->Mean + spread, true );
+    result->ZScore = z;
+    if ( ( last - first ) >= minAccepted )
+    {
+      break;
+    }
+  }
+  if ( first == last )
+  {
+    first = 0;
+    last = stats->Count;
+  }
+  result->Accepted = last - first;
+
+  if ( ( result->Accepted & 0x01 ) != 0 )
+  {
+    result->Median = stats->Samples[first + result->Accepted / 2];
+  }
+  else
+  {
+    result->Median = ( int32_t )( ( ( int64_t )stats->Samples[first + result->Accepted / 2 - 1] + stats->Samples[first + result->Accepted / 2] ) / 2 );
+  }
+  for ( uint8_t i = first; i < last; i++ )
+  {
+    weightedSum += ( int64_t )stats->Samples[i] * stats->Weights[i];
+    weightSum += stats->Weights[i];
+  }
+  result->WeightedMean = ( int32_t )( weightedSum / weightSum );
+
+  return result->Accepted >= minAccepted;
+}
+#endif
+
+#if RADIO_RANGING_ANCHORS > 0
+/*!
+   \brief Starts the exchange of the current slot when it is due. The
+   request address was written when the previous exchange ended, and Poll( )
+   has cleared the IRQ status, so the slot start is a single SetTx
+*/
+void RangingSchedulerTick(void)
+{
+  uint32_t now;
+
+  if ( ( __SchedulerRunning == false ) || ( __SchedulerSlotBusy == true ) )
+  {
+    return;
+  }
+  now = __Transport->GetTime( );
+  if ( ( int32_t )( now - __SchedulerSlotDue ) < 0 )
+  {
+    return;
+  }
+  if ( ( __SchedulerSlotTime != 0 ) && ( ( now - __SchedulerSlotDue ) >= __SchedulerSlotTime ) )
+  {
+    // Late by a whole slot: the following slots are shifted
+    __SchedulerStats.Overruns++;
+    __SchedulerSlotDue = now;
+  }
+  if ( __AnchorSlot == 0 )
+  {
+    __RangingRound.Timestamp = now;
+    __RangingRound.Valid = 0;
+  }
+  __WriteCommand( RADIO_SET_TX, __SchedulerTx, 3 );
+  __OperatingMode = MODE_TX;
+  __SchedulerSlotStart = now;
+  __SchedulerSlotDue += __SchedulerSlotTime;
+  __SchedulerSlotBusy = true;
+}
+
+/*!
+   \brief Sets the anchors ranged in turn, at most RADIO_RANGING_ANCHORS,
+   and stops the scheduler
+
+   \retval      count         Number of anchors kept
+*/
+uint8_t __SetRangingAnchors(const uint32_t *addresses, uint8_t count)
+{
+  if ( count > RADIO_RANGING_ANCHORS )
+  {
+    count = RADIO_RANGING_ANCHORS;
+  }
+  __SchedulerRunning = false;
+  for ( uint8_t i = 0; i < count; i++ )
+  {
+    __Anchors[i][0] = ( uint8_t )( addresses[i] >> 24 );
+    __Anchors[i][1] = ( uint8_t )( addresses[i] >> 16 );
+    __Anchors[i][2] = ( uint8_t )( addresses[i] >> 8 );
+    __Anchors[i][3] = ( uint8_t )addresses[i];
+    __RangingRound.Ranges[i].Address = addresses[i];
+  }
+  __AnchorCount = count;
+  __RangingRound.Count = count;
+  return count;
+}
+
+/*!
+   \brief Ranges the anchors in turn, one per slot, from Poll( ). The radio
+   must be configured as ranging master, with the master result valid and
+   timeout interrupts on DIO1
+
+   \param [in]  slotTime      Slot length [us], 0 to start each exchange as soon as the previous one ends
+   \param [in]  timeout       SetTx timeout of each exchange
+*/
+void __StartRangingScheduler(uint32_t slotTime, TickTime_t timeout)
+{
+  if ( ( __AnchorCount == 0 ) || ( __GetPacketType( true ) != PACKET_TYPE_RANGING ) )
+  {
+    return;
+  }
+#if RADIO_RANGING_RESULTS > 0
+  __ContinuousRanging = false;
+#endif
+  __SchedulerTx[0] = timeout.PeriodBase;
+  __SchedulerTx[1] = ( uint8_t )( ( timeout.PeriodBaseCount >> 8 ) & 0x00FF );
+  __SchedulerTx[2] = ( uint8_t )( timeout.PeriodBaseCount & 0x00FF );
+  __SetRangingRole( RADIO_RANGING_ROLE_MASTER );
+  __WriteRegister( REG_LR_REQUESTRANGINGADDR, __Anchors[0], 4 );
+  __ClearIrqStatus( IRQ_RADIO_ALL );
+
+  __AnchorSlot = 0;
+  __RangingRound.Round = 0;
+  __RangingRoundReady = false;
+  __SchedulerSlotTime = slotTime;
+  __SchedulerSlotDue = __Transport->GetTime( );
+  __SchedulerSlotBusy = false;
+  __SchedulerRunning = true;
+  RangingSchedulerTick( );
+}
+
+/*!
+   \brief Stops the scheduler, the exchange in progress ends normally but
+   its result is not recorded
+*/
+void __StopRangingScheduler(void)
+{
+  __SchedulerRunning = false;
+}
+
+/*!
+   \brief Copies the last completed round
+
+   \retval      available     false when no round completed since the last call
+*/
+bool __GetRangingRound(RadioRangingRound_t *round)
+{
+  if ( __RangingRoundReady == false )
+  {
+    return false;
+  }
+  *round = __RangingRoundDone;
+  __RangingRoundReady = false;
+  return true;
+}
+
+RadioRangingSchedulerStats_t __GetRangingSchedulerStats(void)
+{
+  return __SchedulerStats;
+}
+
+void __ResetRangingSchedulerStats(void)
+{
+  memset( &__SchedulerStats, 0, sizeof( __SchedulerStats ) );
+}
+#endif
+
+#if RADIO_RANGING_RESULTS > 0
+/*!
+   \brief Ranges the current request address over and over. The radio must
+   be configured as ranging master, with the master result valid and timeout
+   interrupts on DIO1. Each exchange is re-armed from Poll( ) as soon as the
+   previous one ends, its result going to ReadRangingSample( )
+
+   \param [in]  timeout       SetTx timeout of each exchange
+*/
+void __StartContinuousRanging(TickTime_t timeout)
+{
+  if ( __GetPacketType( true ) != PACKET_TYPE_RANGING )
+  {
+    return;
+  }
+#if RADIO_RANGING_ANCHORS > 0
+  __SchedulerRunning = false;
+#endif
+  __ContinuousTx[0] = timeout.PeriodBase;
+  __ContinuousTx[1] = ( uint8_t )( ( timeout.PeriodBaseCount >> 8 ) & 0x00FF );
+  __ContinuousTx[2] = ( uint8_t )( timeout.PeriodBaseCount & 0x00FF );
+  __RangingSamplesHead = 0;
+  __RangingSamplesTail = 0;
+  __ContinuousRanging = true;
+  __SetTx( timeout );
+}
+
+/*!
+   \brief Leaves the continuous mode, the exchange in progress ends normally
+   but its result is not queued
+*/
+void __StopContinuousRanging(void)
+{
+  __ContinuousRanging = false;
+}
+
+/*!
+   \brief Takes the oldest result of the continuous mode
+
+   \retval      available     false when no result is waiting
+*/
+bool __ReadRangingSample(RadioRangingSample_t *sample)
+{
+  if ( __RangingSamplesTail == __RangingSamplesHead )
+  {
+    return false;
+  }
+  *sample = __RangingSamples[__RangingSamplesTail & ( RADIO_RANGING_RESULTS - 1 )];
+  __RangingSamplesTail++;
+  return true;
+}
+
+RadioContinuousRangingStats_t __GetContinuousRangingStats(void)
+{
+  return __ContinuousStats;
+}
+
+void __ResetContinuousRangingStats(void)
+{
+  memset( &__ContinuousStats, 0, sizeof( __ContinuousStats ) );
+}
+#endif
+#endif
+
+double __GetFrequencyError()
+{
+  uint32_t efe = 0;
+  double efeHz = 0.0;
+
+  switch ( __GetPacketType( true ) )
+  {
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+      efe = __ReadRegisterRange( REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB, 3 );
+      efe &= REG_LR_ESTIMATED_FREQUENCY_ERROR_MASK;
+
+      efeHz = 1.55 * ( double )complement2( efe, 20 ) / ( 1600.0 / ( double )__GetLoRaBandwidth( ) * 1000.0 );
+      break;
+
+    case PACKET_TYPE_NONE:
+    case PACKET_TYPE_BLE:
+    case PACKET_TYPE_FLRC:
+    case PACKET_TYPE_GFSK:
+      break;
+  }
+
+  return efeHz;
+}
+
+#if RADIO_PACKET_POOL_SIZE > 0
+/*!
+   \brief Reads the received payload and its status into a free slot of the
+   packet pool
+
+   \retval      packet        The filled slot, NULL if the pool is empty or
+                              the payload does not fit
+*/
+RadioPacket_t *PacketPoolFill(uint8_t size, uint8_t offset, uint32_t timestamp)
+{
+  RadioPacket_t *packet;
+  PacketStatus_t status;
+  uint8_t slot = 0;
+
+  if ( __PacketPoolFree == 0 )
+  {
+    return NULL;
+  }
+#if RADIO_PACKET_PAYLOAD_SIZE < 255
+  if ( size > RADIO_PACKET_PAYLOAD_SIZE )
+  {
+    return NULL;
+  }
+#endif
+  while ( ( __PacketPoolFree & ( 1 << slot ) ) == 0 )
+  {
+    slot++;
+  }
+  __PacketPoolFree &= ~( 1 << slot );
+  packet = &__PacketPool[slot];
+
+  __ReadBuffer( offset, packet->Payload, size );
+  packet->Size = size;
+  packet->Timestamp = timestamp;
+  __GetPacketStatus( &status );
+  switch ( status.packetType )
+  {
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+      packet->Rssi = status.LoRa.RssiPkt;
+      packet->Snr = status.LoRa.SnrPkt;
+      break;
+#if RADIO_FEATURE_GFSK
+    case PACKET_TYPE_GFSK:
+      packet->Rssi = status.Gfsk.RssiSync;
+      packet->Snr = 0;
+      break;
+#endif
+#if RADIO_FEATURE_FLRC
+    case PACKET_TYPE_FLRC:
+      packet->Rssi = status.Flrc.RssiSync;
+      packet->Snr = 0;
+      break;
+#endif
+#if RADIO_FEATURE_BLE
+    case PACKET_TYPE_BLE:
+      packet->Rssi = status.Ble.RssiSync;
+      packet->Snr = 0;
+      break;
+#endif
+    default:
+      packet->Rssi = 0;
+      packet->Snr = 0;
+      break;
+  }
+  return packet;
+}
+#endif
+
+/*!
+   \brief Appends an event to the event queue
+
+   \param [in]  param         Error code, ranging code or CAD flag depending on the event type
+*/
+void QueueEvent(RadioEventTypes_t type, uint16_t irqRegs, uint32_t timestamp, uint8_t param)
+{
+  RadioEvent_t *event;
+  uint8_t offset;
+
+  if ( ( uint8_t )( __EventQueueHead - __EventQueueTail ) >= RADIO_EVENT_QUEUE_SIZE )
+  {
+    __DroppedEvents++;
+    return;
+  }
+  event = &__EventQueue[__EventQueueHead & ( RADIO_EVENT_QUEUE_SIZE - 1 )];
+  event->Type = type;
+  event->Timestamp = timestamp;
+  event->IrqStatus = irqRegs;
+  event->Packet = NULL;
+  switch ( type )
+  {
+    case RADIO_EVENT_RX_DONE:
+      __GetRxBufferStatus( &event->RxLength, &offset );
+#if RADIO_PACKET_POOL_SIZE > 0
+      if ( __PacketPoolEnabled == true )
+      {
+        event->Packet = PacketPoolFill( event->RxLength, offset, timestamp );
+      }
+#endif
+      break;
+    case RADIO_EVENT_TX_DONE:
+    case RADIO_EVENT_TX_TIMEOUT:
+#if RADIO_TX_QUEUE_SIZE > 0
+      event->TxQueueLatency = ( __TxQueueBusy == true ) ? __TxQueueLatency : 0;
+#else
+      event->TxQueueLatency = 0;
+#endif
+      break;
+    case RADIO_EVENT_RX_ERROR:
+      event->ErrorCode = ( IrqErrorCode_t )param;
+      break;
+    case RADIO_EVENT_RANGING_DONE:
+      event->RangingCode = ( IrqRangingCode_t )param;
+      break;
+    case RADIO_EVENT_CAD_DONE:
+      event->CadDetected = ( param != 0 );
+      break;
+    default:
+      break;
+  }
+  __EventQueueHead++;
+}
+
+/*!
+   \brief What the decoder does for one asserted IRQ bit
+*/
+typedef enum
+{
+  IRQ_ACTION_NONE                         = 0x00,
+  IRQ_ACTION_TX_DONE,
+  IRQ_ACTION_TX_TIMEOUT,
+  IRQ_ACTION_RX_DONE,                                     //!< rxDone, or rxError on CRC or sync word error
+  IRQ_ACTION_RX_DONE_LORA,                                //!< rxDone, or rxError on CRC error
+  IRQ_ACTION_RX_TIMEOUT,                                  //!< rxTimeout, unless a CAD completed
+  IRQ_ACTION_SYNCWORD_VALID,
+  IRQ_ACTION_SYNCWORD_ERROR,
+  IRQ_ACTION_HEADER_VALID,
+  IRQ_ACTION_HEADER_ERROR,
+  IRQ_ACTION_RANGING_ON_LORA,
+  IRQ_ACTION_CAD_DONE,
+  IRQ_ACTION_RANGING_SLAVE_ERROR,
+  IRQ_ACTION_RANGING_SLAVE_VALID,
+  IRQ_ACTION_RANGING_MASTER_ERROR,
+  IRQ_ACTION_RANGING_MASTER_VALID,
+} IrqActions_t;
+
+/*!
+   \brief Sets of actions, one bit per action
+*/
+#define IRQ_ACTION_MASK( action )                   ( ( uint16_t )1 << ( action ) )
+#define IRQ_ACTIONS_TX_END                          ( IRQ_ACTION_MASK( IRQ_ACTION_TX_DONE ) | IRQ_ACTION_MASK( IRQ_ACTION_TX_TIMEOUT ) )
+#define IRQ_ACTIONS_MASTER_DONE                     ( IRQ_ACTION_MASK( IRQ_ACTION_RANGING_MASTER_ERROR ) | \
+                                                      IRQ_ACTION_MASK( IRQ_ACTION_RANGING_MASTER_VALID ) )
+#define IRQ_ACTIONS_RANGING_DONE                    ( IRQ_ACTION_MASK( IRQ_ACTION_RANGING_SLAVE_ERROR ) | \
+                                                      IRQ_ACTION_MASK( IRQ_ACTION_RANGING_SLAVE_VALID ) | IRQ_ACTIONS_MASTER_DONE )
+
+/*!
+   \brief Places the 4-bit action of one IRQ bit at the position of that bit
+*/
+constexpr uint64_t IrqEntry(uint16_t irq, IrqActions_t action)
+{
+  return ( uint64_t )action << ( 4 * __builtin_ctz( irq ) );
+}
+
+/*!
+   \brief Computes the mask of the IRQ bits having an action in a row
+*/
+constexpr uint16_t IrqRowMask(uint64_t actions, uint8_t bit = 0)
+{
+  return ( bit == 16 ) ? 0 : ( ( ( ( actions >> ( 4 * bit ) ) & 0x0F ) != 0 ) ? ( 1 << bit ) : 0 ) | IrqRowMask( actions, bit + 1 );
+}
+
+/*!
+   \brief Extracts the action of one IRQ bit, when the table is built
+*/
+constexpr uint8_t IrqRowAction(uint64_t actions, uint8_t bit)
+{
+  return ( actions >> ( 4 * bit ) ) & 0x0F;
+}
+
+/*!
+   \brief The actions of the 16 IRQ bits for one packet type and operating
+   mode, one byte per bit so the decoder reads them without shifting
+*/
+typedef struct
+{
+  uint8_t Actions[16];                                    //!< Action per IRQ bit
+  uint16_t Mask;                                          //!< IRQ bits having an action
+} IrqDispatchRow_t;
+
+#define IRQ_ROW( actions )                          { { IrqRowAction( actions, 0 ), IrqRowAction( actions, 1 ), IrqRowAction( actions, 2 ), \
+                                                        IrqRowAction( actions, 3 ), IrqRowAction( actions, 4 ), IrqRowAction( actions, 5 ), \
+                                                        IrqRowAction( actions, 6 ), IrqRowAction( actions, 7 ), IrqRowAction( actions, 8 ), \
+                                                        IrqRowAction( actions, 9 ), IrqRowAction( actions, 10 ), IrqRowAction( actions, 11 ), \
+                                                        IrqRowAction( actions, 12 ), IrqRowAction( actions, 13 ), IrqRowAction( actions, 14 ), \
+                                                        IrqRowAction( actions, 15 ) }, IrqRowMask( actions ) }
+
+/*!
+   \brief Packet types and operating modes handled by the IRQ dispatch table
+*/
+#define IRQ_CLASS_FSK                               0   // GFSK, FLRC and BLE
+#define IRQ_CLASS_LORA                              1
+#define IRQ_CLASS_RANGING                           2
+#define IRQ_CLASS_COUNT                             3
+
+// In the order of MODE_RX, MODE_TX and MODE_CAD
+#define IRQ_MODE_RX                                 0
+#define IRQ_MODE_TX                                 1
+#define IRQ_MODE_CAD                                2
+#define IRQ_MODE_COUNT                              3
+
+/*!
+   \brief IRQ class of each packet type, indexed by RadioPacketTypes_t
+*/
+static const uint8_t IrqClasses[PACKET_TYPE_BLE + 1] =
+{
+  IRQ_CLASS_FSK,                                          // PACKET_TYPE_GFSK
+  IRQ_CLASS_LORA,                                         // PACKET_TYPE_LORA
+  IRQ_CLASS_RANGING,                                      // PACKET_TYPE_RANGING
+  IRQ_CLASS_FSK,                                          // PACKET_TYPE_FLRC
+  IRQ_CLASS_FSK,                                          // PACKET_TYPE_BLE
+};
+
+/*!
+   \brief IRQ dispatch table, indexed by packet type class and operating mode
+*/
+static const IrqDispatchRow_t IrqDispatchTable[IRQ_CLASS_COUNT][IRQ_MODE_COUNT] =
+{
+  // IRQ_CLASS_FSK
+  {
+    IRQ_ROW( IrqEntry( IRQ_RX_DONE, IRQ_ACTION_RX_DONE ) |
+             IrqEntry( IRQ_SYNCWORD_VALID, IRQ_ACTION_SYNCWORD_VALID ) |
+             IrqEntry( IRQ_SYNCWORD_ERROR, IRQ_ACTION_SYNCWORD_ERROR ) |
+             IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RX_TIMEOUT ) ),
+    IRQ_ROW( IrqEntry( IRQ_TX_DONE, IRQ_ACTION_TX_DONE ) |
+             IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_TX_TIMEOUT ) ),
+    IRQ_ROW( 0 ),
+  },
+  // IRQ_CLASS_LORA
+  {
+    IRQ_ROW( IrqEntry( IRQ_RX_DONE, IRQ_ACTION_RX_DONE_LORA ) |
+             IrqEntry( IRQ_HEADER_VALID, IRQ_ACTION_HEADER_VALID ) |
+             IrqEntry( IRQ_HEADER_ERROR, IRQ_ACTION_HEADER_ERROR ) |
+             IrqEntry( IRQ_RANGING_SLAVE_REQUEST_DISCARDED, IRQ_ACTION_RANGING_ON_LORA ) |
+             IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RX_TIMEOUT ) ),
+    IRQ_ROW( IrqEntry( IRQ_TX_DONE, IRQ_ACTION_TX_DONE ) |
+             IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_TX_TIMEOUT ) ),
+    IRQ_ROW( IrqEntry( IRQ_CAD_DONE, IRQ_ACTION_CAD_DONE ) |
+             IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RX_TIMEOUT ) ),
+  },
+  // IRQ_CLASS_RANGING: MODE_RX is the slave side, MODE_TX the master side
+  {
+    IRQ_ROW( IrqEntry( IRQ_HEADER_VALID, IRQ_ACTION_HEADER_VALID ) |
+             IrqEntry( IRQ_HEADER_ERROR, IRQ_ACTION_HEADER_ERROR ) |
+             IrqEntry( IRQ_RANGING_SLAVE_RESPONSE_DONE, IRQ_ACTION_RANGING_SLAVE_VALID ) |
+             IrqEntry( IRQ_RANGING_SLAVE_REQUEST_DISCARDED, IRQ_ACTION_RANGING_SLAVE_ERROR ) |
+             IrqEntry( IRQ_RANGING_SLAVE_REQUEST_VALID, IRQ_ACTION_RANGING_SLAVE_VALID ) |
+             IrqEntry( IRQ_RX_TX_TIMEOUT, IRQ_ACTION_RANGING_SLAVE_ERROR ) ),
+    IRQ_ROW( IrqEntry( IRQ_RANGING_MASTER_RESULT_VALID, IRQ_ACTION_RANGING_MASTER_VALID ) |
+             IrqEntry( IRQ_RANGING_MASTER_TIMEOUT, IRQ_ACTION_RANGING_MASTER_ERROR ) ),
+    IRQ_ROW( 0 ),
+  },
+};
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+/*!
+   \brief Records the result of the slot when its exchange ends and writes
+   the request address of the next anchor while the radio is idle
+*/
+void RangingSchedulerOnIrq(IrqActions_t action)
+{
+  RadioAnchorRange_t *range;
+  uint32_t now;
+  uint32_t latency;
+
+  if ( ( __SchedulerSlotBusy == false ) ||
+       ( ( action != IRQ_ACTION_RANGING_MASTER_VALID ) && ( action != IRQ_ACTION_RANGING_MASTER_ERROR ) ) )
+  {
+    return;
+  }
+  __SchedulerSlotBusy = false;
+  if ( __SchedulerRunning == false )
+  {
+    return;
+  }
+
+  range = &__RangingRound.Ranges[__AnchorSlot];
+  if ( action == IRQ_ACTION_RANGING_MASTER_VALID )
+  {
+    RadioRangingResult_t result = __GetCompensatedRangingResult( RANGING_RESULT_RAW );
+
+    range->Rssi = result.Rssi;
+    range->Distance = result.Corrected;
+    range->Valid = true;
+    __RangingRound.Valid++;
+  }
+  else
+  {
+    range->Rssi = 0;
+    range->Distance = 0;
+    range->Valid = false;
+    __SchedulerStats.Failed++;
+  }
+
+  now = __Transport->GetTime( );
+  latency = now - __SchedulerSlotStart;
+  __SchedulerStats.Slots++;
+  __SchedulerStats.TotalLatency += latency;
+  if ( latency > __SchedulerStats.MaxLatency )
+  {
+    __SchedulerStats.MaxLatency = latency;
+  }
+
+  if ( ++__AnchorSlot >= __AnchorCount )
+  {
+    __AnchorSlot = 0;
+    __RangingRound.Duration = now - __RangingRound.Timestamp;
+    if ( __RangingRoundReady == true )
+    {
+      __SchedulerStats.Dropped++;
+    }
+    __RangingRoundDone = __RangingRound;
+    __RangingRoundReady = true;
+    __RangingRound.Round++;
+    __SchedulerStats.Rounds++;
+  }
+  if ( __AnchorCount > 1 )
+  {
+    __WriteRegister( REG_LR_REQUESTRANGINGADDR, __Anchors[__AnchorSlot], 4 );
+  }
+  if ( __SchedulerSlotTime == 0 )
+  {
+    __SchedulerSlotDue = now;
+  }
+}
+#endif
+
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+/*!
+   \brief Queues the result of a valid exchange of the continuous mode
+*/
+void RangingContinuousRead(IrqActions_t action, uint32_t timestamp)
+{
+  RadioRangingSample_t *sample;
+  RadioRangingResult_t result;
+
+  if ( ( __ContinuousRanging == false ) || ( action != IRQ_ACTION_RANGING_MASTER_VALID ) )
+  {
+    return;
+  }
+  __ContinuousStats.Measures++;
+  if ( ( uint8_t )( __RangingSamplesHead - __RangingSamplesTail ) >= RADIO_RANGING_RESULTS )
+  {
+    __ContinuousStats.Overflows++;
+    return;
+  }
+  sample = &__RangingSamples[__RangingSamplesHead & ( RADIO_RANGING_RESULTS - 1 )];
+  result = __GetCompensatedRangingResult( RANGING_RESULT_RAW );
+  sample->Timestamp = timestamp;
+  sample->Rssi = result.Rssi;
+  sample->Distance = result.Corrected;
+  __RangingSamplesHead++;
+}
+
+/*!
+   \brief Re-arms the continuous mode with the same configuration. Poll( )
+   has cleared the IRQ status, so this is a single SetTx
+*/
+void RangingContinuousNext(bool valid, uint32_t timestamp)
+{
+  uint32_t latency;
+
+  if ( __ContinuousRanging == false )
+  {
+    return;
+  }
+  if ( valid == false )
+  {
+    __ContinuousStats.Failed++;
+  }
+  __WriteCommand( RADIO_SET_TX, __ContinuousTx, 3 );
+  __OperatingMode = MODE_TX;
+
+  latency = __Transport->GetTime( ) - timestamp;
+  __ContinuousStats.TotalRearm += latency;
+  if ( latency > __ContinuousStats.MaxRearm )
+  {
+    __ContinuousStats.MaxRearm = latency;
+  }
+}
+#endif
+
+/*!
+   \brief Retunes and restarts the radio once per IRQ status, however many
+   of its bits map to these actions: the hop first, once the ranging results
+   are read, then the next frame of the TX queue or the next exchange of the
+   continuous ranging on the new channel
+
+   \param [in]  actions       IRQ_ACTION_MASK( ) of every action run for the status
+*/
+void FinishIrqActions(uint16_t actions, uint32_t timestamp)
+{
+#if RADIO_HOP_CHANNELS > 0
+  uint16_t hopActions = 0;
+
+  if ( ( __HopTriggers & RADIO_HOP_ON_TX_DONE ) != 0 )
+  {
+    hopActions |= IRQ_ACTION_MASK( IRQ_ACTION_TX_DONE );
+  }
+  if ( ( __HopTriggers & RADIO_HOP_ON_RANGING_DONE ) != 0 )
+  {
+    hopActions |= IRQ_ACTIONS_RANGING_DONE;
+  }
+  if ( ( actions & hopActions ) != 0 )
+  {
+    HopNext( timestamp );
+  }
+#endif
+#if RADIO_TX_QUEUE_SIZE > 0
+  if ( ( actions & IRQ_ACTIONS_TX_END ) != 0 )
+  {
+    TxQueueNext( );
+  }
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+  if ( ( actions & IRQ_ACTIONS_MASTER_DONE ) != 0 )
+  {
+    RangingContinuousNext( ( actions & IRQ_ACTION_MASK( IRQ_ACTION_RANGING_MASTER_VALID ) ) != 0, timestamp );
+  }
+#endif
+}
+
+/*!
+   \brief Decodes an IRQ status into events appended to the event queue
+
+   Every asserted IRQ bit handled in the current packet type and operating
+   mode is visited once, from the least significant one: its action is read
+   from the row and run in place, then FinishIrqActions( ) runs once
+*/
+void DecodeIrqs(uint16_t irqRegs, uint32_t timestamp)
+{
+  RadioPacketTypes_t packetType = __GetPacketType( true );
+  uint8_t irqMode = ( uint8_t )( __OperatingMode - MODE_RX );
+
+  if ( ( packetType > PACKET_TYPE_BLE ) || ( irqMode >= IRQ_MODE_COUNT ) )
+  {
+    // Unexpected IRQ: silently returns
+    return;
+  }
+
+  const IrqDispatchRow_t *row = &IrqDispatchTable[IrqClasses[packetType]][irqMode];
+  uint16_t pending = irqRegs & row->Mask;
+  uint16_t actions = 0;
+
+  while ( pending != 0 )
+  {
+    IrqActions_t action = ( IrqActions_t )row->Actions[__builtin_ctz( pending )];
+
+    pending &= pending - 1;
+    actions |= IRQ_ACTION_MASK( action );
+    switch ( action )
+    {
+      case IRQ_ACTION_TX_DONE:
+        QueueEvent( RADIO_EVENT_TX_DONE, irqRegs, timestamp, 0 );
+        break;
+      case IRQ_ACTION_TX_TIMEOUT:
+        QueueEvent( RADIO_EVENT_TX_TIMEOUT, irqRegs, timestamp, 0 );
+        break;
+      case IRQ_ACTION_RX_DONE:
+        if ( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
+        {
+          QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_CRC_ERROR_CODE );
+        }
+        else if ( ( irqRegs & IRQ_SYNCWORD_ERROR ) == IRQ_SYNCWORD_ERROR )
+        {
+          QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_SYNCWORD_ERROR_CODE );
+        }
+        else
+        {
+          QueueEvent( RADIO_EVENT_RX_DONE, irqRegs, timestamp, 0 );
+        }
+        break;
+      case IRQ_ACTION_RX_DONE_LORA:
+        if ( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
+        {
+          QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_CRC_ERROR_CODE );
+        }
+        else
+        {
+          QueueEvent( RADIO_EVENT_RX_DONE, irqRegs, timestamp, 0 );
+        }
+        break;
+      case IRQ_ACTION_RX_TIMEOUT:
+        // A completed CAD takes precedence over its timeout
+        if ( ( __OperatingMode != MODE_CAD ) || ( ( irqRegs & IRQ_CAD_DONE ) != IRQ_CAD_DONE ) )
+        {
+          QueueEvent( RADIO_EVENT_RX_TIMEOUT, irqRegs, timestamp, 0 );
+        }
+        break;
+      case IRQ_ACTION_SYNCWORD_VALID:
+        QueueEvent( RADIO_EVENT_RX_SYNCWORD_DONE, irqRegs, timestamp, 0 );
+        break;
+      case IRQ_ACTION_SYNCWORD_ERROR:
+        QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_SYNCWORD_ERROR_CODE );
+        break;
+      case IRQ_ACTION_HEADER_VALID:
+        QueueEvent( RADIO_EVENT_RX_HEADER_DONE, irqRegs, timestamp, 0 );
+        break;
+      case IRQ_ACTION_HEADER_ERROR:
+        QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_HEADER_ERROR_CODE );
+        break;
+      case IRQ_ACTION_RANGING_ON_LORA:
+        QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_RANGING_ON_LORA_ERROR_CODE );
+        break;
+      case IRQ_ACTION_CAD_DONE:
+        QueueEvent( RADIO_EVENT_CAD_DONE, irqRegs, timestamp, ( irqRegs & IRQ_CAD_DETECTED ) == IRQ_CAD_DETECTED );
+        break;
+      case IRQ_ACTION_RANGING_SLAVE_ERROR:
+        QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_SLAVE_ERROR_CODE );
+        break;
+      case IRQ_ACTION_RANGING_SLAVE_VALID:
+        QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_SLAVE_VALID_CODE );
+        break;
+      case IRQ_ACTION_RANGING_MASTER_ERROR:
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+        RangingSchedulerOnIrq( action );
+#endif
+        QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_MASTER_ERROR_CODE );
+        break;
+      case IRQ_ACTION_RANGING_MASTER_VALID:
+        // The result registers are read before a hop retunes the radio
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+        RangingSchedulerOnIrq( action );
+#endif
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_RESULTS > 0 )
+        RangingContinuousRead( action, timestamp );
+#endif
+        QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_MASTER_VALID_CODE );
+        break;
+      default:
+        break;
+    }
+  }
+  if ( ( actions & ( IRQ_ACTIONS_TX_END | IRQ_ACTIONS_RANGING_DONE ) ) != 0 )
+  {
+    FinishIrqActions( actions, timestamp );
+  }
+}
+
+/*!
+   \brief Reads, clears and decodes the IRQ status. Only the bits read are
+   cleared: an IRQ latching in between stays pending, and as it keeps DIO1
+   high without a new edge, the status is read again while DIO1 is high
+
+   \param [in]  timestamp     Time of the DIO1 edge for the bits read first [us]
+*/
+void ServiceIrqs(uint32_t timestamp)
+{
+  uint16_t irqRegs = __GetIrqStatus( );
+
+  while ( irqRegs != 0 )
+  {
+    __ClearIrqStatus( irqRegs );
+    DecodeIrqs( irqRegs, timestamp );
+    if ( ( __Transport->ReadDio( ) & 0x02 ) == 0 )
+    {
+      break;
+    }
+    irqRegs = __GetIrqStatus( );
+    timestamp = __Transport->GetTime( );
+  }
+}
+
+bool __Poll(RadioEvent_t *event)
+{
+  // Decode every DIO1 edge recorded by the interrupt since the last call. An
+  // edge whose IRQ was already read with the previous one finds it cleared
+  while ( __IrqQueueTail != __IrqQueueHead )
+  {
+    uint32_t timestamp = __IrqQueue[__IrqQueueTail & ( RADIO_IRQ_QUEUE_SIZE - 1 )];
+    __IrqQueueTail++;
+
+    ServiceIrqs( timestamp );
+  }
+#if RADIO_FEATURE_RANGING && ( RADIO_RANGING_ANCHORS > 0 )
+  RangingSchedulerTick( );
+#endif
+
+  if ( __EventQueueTail == __EventQueueHead )
+  {
+    event->Type = RADIO_EVENT_NONE;
+    return false;
+  }
+  *event = __EventQueue[__EventQueueTail & ( RADIO_EVENT_QUEUE_SIZE - 1 )];
+  __EventQueueTail++;
+  return true;
+}
+
+void __Dispatch(void)
+{
+  RadioEvent_t event;
+
+  while ( __Poll( &event ) == true )
+  {
+#if RADIO_PACKET_POOL_SIZE > 0
+    __DispatchedPacket = event.Packet;
+#endif
+    if ( __callbacks == NULL )
+    {
+#if RADIO_PACKET_POOL_SIZE > 0
+      __ReleasePacket( __DispatchedPacket );
+      __DispatchedPacket = NULL;
+#endif
+      continue;
+    }
+    switch ( event.Type )
+    {
+      case RADIO_EVENT_TX_DONE:
+        if ( __callbacks->txDone != NULL )
+        {
+          __callbacks->txDone( );
+        }
+        break;
+      case RADIO_EVENT_RX_DONE:
+        if ( __callbacks->rxDone != NULL )
+        {
+          __callbacks->rxDone( );
+        }
+#if RADIO_PACKET_POOL_SIZE > 0
+        __ReleasePacket( __DispatchedPacket );
+        __DispatchedPacket = NULL;
+#endif
+        break;
+      case RADIO_EVENT_RX_SYNCWORD_DONE:
+        if ( __callbacks->rxSyncWordDone != NULL )
+        {
+          __callbacks->rxSyncWordDone( );
+        }
+        break;
+      case RADIO_EVENT_RX_HEADER_DONE:
+        if ( __callbacks->rxHeaderDone != NULL )
+        {
+          __callbacks->rxHeaderDone( );
+        }
+        break;
+      case RADIO_EVENT_TX_TIMEOUT:
+        if ( __callbacks->txTimeout != NULL )
+        {
+          __callbacks->txTimeout( );
+        }
+        break;
+      case RADIO_EVENT_RX_TIMEOUT:
+        if ( __callbacks->rxTimeout != NULL )
+        {
+          __callbacks->rxTimeout( );
+        }
+        break;
+      case RADIO_EVENT_RX_ERROR:
+        if ( __callbacks->rxError != NULL )
+        {
+          __callbacks->rxError( event.ErrorCode );
+        }
+        break;
+      case RADIO_EVENT_RANGING_DONE:
+        if ( __callbacks->rangingDone != NULL )
+        {
+          __callbacks->rangingDone( event.RangingCode );
+        }
+        break;
+      case RADIO_EVENT_CAD_DONE:
+        if ( __callbacks->cadDone != NULL )
+        {
+          __callbacks->cadDone( event.CadDetected );
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+uint16_t __GetDroppedEvents(void)
+{
+  uint16_t dropped;
+
+  // Read until stable, the interrupt may update the counter between its bytes
+  do
+  {
+    dropped = __DroppedIrqs;
+  } while ( dropped != __DroppedIrqs );
+  return __DroppedEvents + dropped;
+}
+
+void __ProcessIrqs(void)
+{
+  if ( __PollingMode == true )
+  {
+    if ( __IrqState == true )
+    {
+      // __disable_irq( );
+      __IrqState = false;
+      // __enable_irq( );
+    }
+    else
+    {
+      return;
+    }
+  }
+
+  ServiceIrqs( __Transport->GetTime( ) );
+
+  __Dispatch( );
+}
+
+void __ForcePreambleLength(RadioPreambleLengths_t preambleLength)
+{
+  __WriteRegister_1( REG_LR_PREAMBLELENGTH, ( __ReadRegister_1( REG_LR_PREAMBLELENGTH ) & MASK_FORCE_PREAMBLELENGTH ) | preambleLength );
+}
@@ -2,8 +2,9 @@
 #define __RADIO_METHODS_H__
 
 #include "Header.h"
+#include "Transport.h"
 
-void __Init(RadioCallbacks_t* callbacks);
+bool __Init(RadioCallbacks_t* callbacks);
 void __SetPollingMode(void);
 void __SetInterruptMode(void);
 void __SetRegistersDefault(void);
@@ -15,6 +16,7 @@ void __ReadCommand(RadioCommands_t opcode, uint8_t *buffer, uint16_t size);
 void __WriteRegister(uint16_t address, uint8_t *buffer, uint16_t size);
 //void __WriteRegister(uint16_t address, uint8_t value);
 void __ReadRegister(uint16_t address, uint8_t *buffer, uint16_t size);
+uint32_t __ReadRegisterRange(uint16_t address, uint8_t size);
 //uint8_t __ReadRegister(uint16_t address);
 void __WriteBuffer(uint8_t offset, uint8_t *buffer, uint8_t size);
 void __ReadBuffer(uint8_t offset, uint8_t *buffer, uint8_t size);
@@ -53,22 +55,96 @@ void __SetLongPreamble(bool enable);
 void __SetPayload(uint8_t *payload, uint8_t size, uint8_t offsetx00);
 uint8_t __GetPayload(uint8_t *payload, uint8_t *size, uint8_t maxSize);
 void __SendPayload(uint8_t *payload, uint8_t size, TickTime_t timeout, uint8_t offset);
+#if RADIO_FEATURE_SYNC_WORD
 uint8_t __SetSyncWord(uint8_t syncWordIdx, uint8_t *syncWord);
 void __SetSyncWordErrorTolerance(uint8_t errorBits);
 uint8_t __SetCrcSeed(uint8_t *seed);
+#endif
+#if RADIO_FEATURE_BLE
 void __SetBleAccessAddress(uint32_t accessAddress);
 void __SetBleAdvertizerAccessAddress(void);
+#endif
+#if RADIO_FEATURE_SYNC_WORD
 void __SetCrcPolynomial(uint16_t polynomial);
 void __SetWhiteningSeed(uint8_t seed);
+#endif
+#if RADIO_FEATURE_RANGING
 void __SetRangingIdLength(RadioRangingIdCheckLengths_t length);
 void __SetDeviceRangingAddress(uint32_t address);
 void __SetRangingRequestAddress(uint32_t address);
 double __GetRangingResult(RadioRangingResultTypes_t resultType);
+int32_t __GetRangingResultQ8(RadioRangingResultTypes_t resultType);
+int32_t __RangingShortRangeCorrection(int32_t distance, int8_t rssi);
 void __SetRangingCalibration(uint16_t cal);
 void __RangingClearFilterResult(void);
 void __RangingSetFilterNumSamples(uint8_t numSample);
+#if RADIO_RANGING_STATS_SIZE > 0
+void __RangingStatsReset(RadioRangingStats_t *stats);
+bool __RangingStatsAdd(RadioRangingStats_t *stats, int32_t distance, int8_t rssi);
+bool __RangingStatsGetResult(const RadioRangingStats_t *stats, uint8_t minAccepted, RadioRangingStatsResult_t *result);
+#endif
+#if RADIO_RANGING_ANCHORS > 0
+uint8_t __SetRangingAnchors(const uint32_t *addresses, uint8_t count);
+void __StartRangingScheduler(uint32_t slotTime, TickTime_t timeout);
+void __StopRangingScheduler(void);
+bool __GetRangingRound(RadioRangingRound_t *round);
+RadioRangingSchedulerStats_t __GetRangingSchedulerStats(void);
+void __ResetRangingSchedulerStats(void);
+#endif
+#if RADIO_RANGING_RESULTS > 0
+void __StartContinuousRanging(TickTime_t timeout);
+void __StopContinuousRanging(void);
+bool __ReadRangingSample(RadioRangingSample_t *sample);
+RadioContinuousRangingStats_t __GetContinuousRangingStats(void);
+void __ResetContinuousRangingStats(void);
+#endif
+bool __SetRangingProfile(RadioLoRaBandwidths_t bandwidth, RadioLoRaSpreadingFactors_t spreadingFactor);
+int16_t __GetRangingFeiGradient(void);
+RadioRangingResult_t __GetCompensatedRangingResult(RadioRangingResultTypes_t resultType);
+#endif
 double __GetFrequencyError();
 void __ProcessIrqs(void);
+bool __Poll(RadioEvent_t *event);
+void __Dispatch(void);
+uint16_t __GetDroppedEvents(void);
 void __ForcePreambleLength(RadioPreambleLengths_t preambleLength);
+void __SetTransport(const RadioTransport_t *transport);
+bool __WaitForIrq(uint32_t timeout);
+uint32_t __GetSpiTransactionCount(void);
+void __ResetSpiTransactionCount(void);
+void __SetRegisterCache(bool enable);
+RadioRegCacheStats_t __GetRegisterCacheStats(void);
+void __ResetRegisterCacheStats(void);
+void __SetLazyBusy(bool enable);
+#if RADIO_PACKET_POOL_SIZE > 0
+void __SetPacketPool(bool enable);
+RadioPacket_t *__GetRxPacket(void);
+void __ReleasePacket(RadioPacket_t *packet);
+uint8_t __GetFreePackets(void);
+#endif
+uint8_t __ReadRxFrame(RadioRxFrame_t *frame, uint8_t *payload, uint8_t maxSize);
+#if RADIO_TX_QUEUE_SIZE > 0
+bool __EnqueuePayload(uint8_t *payload, uint8_t size, TickTime_t timeout);
+uint8_t __GetTxQueueCount(void);
+RadioTxQueueStats_t __GetTxQueueStats(void);
+void __ResetTxQueueStats(void);
+void __SetTxDoubleBuffer(bool enable);
+#endif
+#if RADIO_FEATURE_PROFILES
+void __BuildProfile(RadioProfile_t *profile, const RadioProfileParams_t *params);
+uint8_t __ApplyProfile(const RadioProfile_t *profile);
+#endif
+#if RADIO_HOP_CHANNELS > 0
+uint8_t __SetHopChannels(const uint32_t *frequencies, uint8_t count);
+void __SetHopSequence(const uint8_t *sequence, uint8_t length);
+void __SetHopTrigger(uint8_t triggers);
+uint8_t __Hop(void);
+RadioHopStats_t __GetHopStats(void);
+void __ResetHopStats(void);
+#endif
+void __SetBusyWaitParams(RadioBusyWaitParams_t *params);
+RadioErrors_t __GetLastError(void);
+void __DumpBusyHistogram(void (*print)(const char *line));
+void __ResetBusyHistogram(void);
 
 #endif /* __RADIO_METHODS_H__ */
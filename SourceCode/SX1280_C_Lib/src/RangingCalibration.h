@@ -0,0 +1,56 @@
+/*
+   Ranging calibration of the SX1280 by LoRa bandwidth and spreading factor
+
+   Generated by Simulator/RangingCalibFit, do not edit: log new calibration
+   runs and run the generator again. Include after the radio header, which
+   defines the LORA_BW_ and LORA_SF values.
+*/
+#ifndef __RANGING_CALIBRATION_H__
+#define __RANGING_CALIBRATION_H__
+
+#include <stdint.h>
+
+#define RANGING_CALIBRATION_BW_COUNT                3
+#define RANGING_CALIBRATION_SF_COUNT                6
+
+/*!
+   \brief Ranging calibration register values
+                                                              SF5     SF6     SF7     SF8     SF9     SF10
+*/
+static const uint16_t RangingCalibrations[RANGING_CALIBRATION_BW_COUNT][RANGING_CALIBRATION_SF_COUNT] = {
+  { 10299,  10271,  10244,  10242,  10230,  10246  },     // LORA_BW_0400
+  { 11486,  11474,  11453,  11426,  11417,  11401  },     // LORA_BW_0800
+  { 13308,  13493,  13528,  13515,  13430,  13376  },     // LORA_BW_1600
+};
+
+/*!
+   \brief Distance error per frequency error [mm/kHz], subtracted from the
+   raw distance times the frequency error the slave measures on the
+   master's request, as the DevKit demo relays it
+                                                              SF5     SF6     SF7     SF8     SF9     SF10
+*/
+static const int16_t RangingFeiGradients[RANGING_CALIBRATION_BW_COUNT][RANGING_CALIBRATION_SF_COUNT] = {
+  { -148,   -214,   -419,   -853,   -1686,  -3423  },     // LORA_BW_0400
+  { -41,    -811,   -218,   -429,   -853,   -1737  },     // LORA_BW_0800
+  { 103,    -41,    -101,   -211,   -424,   -870   },     // LORA_BW_1600
+};
+
+/*!
+   \brief Row of the tables for a bandwidth, RANGING_CALIBRATION_BW_COUNT
+   when it is not calibrated
+*/
+static inline uint8_t RangingCalibrationRow( uint8_t bandwidth )
+{
+  return ( bandwidth == LORA_BW_0400 ) ? 0 : ( bandwidth == LORA_BW_0800 ) ? 1 : ( bandwidth == LORA_BW_1600 ) ? 2 : RANGING_CALIBRATION_BW_COUNT;
+}
+
+/*!
+   \brief Column of the tables for a spreading factor,
+   RANGING_CALIBRATION_SF_COUNT when it is not calibrated
+*/
+static inline uint8_t RangingCalibrationColumn( uint8_t spreadingFactor )
+{
+  return ( ( spreadingFactor >= LORA_SF5 ) && ( spreadingFactor <= LORA_SF10 ) ) ? ( spreadingFactor >> 4 ) - 5 : RANGING_CALIBRATION_SF_COUNT;
+}
+
+#endif /* __RANGING_CALIBRATION_H__ */
@@ -0,0 +1,90 @@
+#ifndef __TRANSPORT_H__
+#define __TRANSPORT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*!
+   \brief Function run on every DIO1 interrupt
+*/
+typedef void ( *RadioIrqHandler_t )( void );
+
+/*!
+   \brief Hardware access used by the driver to talk to the radio
+
+   \remark Select the backend with Radio.SetTransport( ) before Radio.Init( )
+*/
+typedef struct
+{
+  bool (*Init)(void);                                 //!< Configures the SPI bus and the NSS, NRESET, BUSY and DIO lines, false on failure
+  void (*Reset)(void);                                //!< Pulses the NRESET line
+  void (*Transfer)(uint8_t *frame, uint16_t size);    //!< Full duplex block transfer, the received bytes overwrite the frame
+  void (*ChipSelect)(bool select);                    //!< Drives NSS, true selects the radio (NSS low)
+  bool (*ReadBusy)(void);                             //!< Returns true while the BUSY line is high
+  uint8_t (*ReadDio)(void);                           //!< Returns the DIO lines as [ DIO3 | DIO2 | DIO1 | BUSY ]
+  void (*AttachIrq)(RadioIrqHandler_t handler);       //!< Registers the handler run on DIO1 rising edge
+  bool (*WaitForIrq)(uint32_t timeout);               //!< Waits at most timeout [ms] for DIO1, returns false on timeout
+  uint32_t (*GetTime)(void);                          //!< Returns a free running time in microseconds
+  void (*Yield)(void);                                //!< Lets other tasks run while the driver waits
+  void (*Sleep)(uint32_t time);                       //!< Suspends the caller for time [us]
+} RadioTransport_t;
+
+/*!
+   \brief Arduino SPI library and GPIOs, using the pins from Config.h
+*/
+extern const RadioTransport_t ArduinoTransport;
+
+/*!
+   \brief Linux spidev device and libgpiod lines, using the LINUX_* settings from Config.h
+
+   \remark There is no interrupt context on Linux: the IRQ handler is run by
+           WaitForIrq( ) from the calling thread
+*/
+extern const RadioTransport_t LinuxTransport;
+
+/*!
+   \brief In-memory transport without any hardware, for host builds and tests
+
+   Every frame sent is recorded and answered with the bytes queued by
+   LoopbackTransport_SetResponse( ), or echoed back when nothing is queued.
+*/
+extern const RadioTransport_t LoopbackTransport;
+
+/*!
+   \brief Counters maintained by the loopback transport
+*/
+typedef struct
+{
+  uint32_t Transactions;                              //!< Number of frames transferred under one chip select
+  uint32_t Bytes;                                     //!< Number of bytes clocked on the bus
+} LoopbackStats_t;
+
+/*!
+   \brief Queues the bytes clocked out by the radio during the next transfer
+*/
+void LoopbackTransport_SetResponse(const uint8_t *response, uint16_t size);
+
+/*!
+   \brief Returns the last frame written by the driver and its size
+*/
+const uint8_t *LoopbackTransport_GetLastFrame(uint16_t *size);
+
+/*!
+   \brief Forces the level of the simulated BUSY line
+*/
+void LoopbackTransport_SetBusy(bool busy);
+
+/*!
+   \brief Simulates a DIO1 rising edge
+*/
+void LoopbackTransport_RaiseIrq(void);
+
+/*!
+   \brief Sets the time returned by the loopback transport, in microseconds
+*/
+void LoopbackTransport_SetTime(uint32_t time);
+
+LoopbackStats_t LoopbackTransport_GetStats(void);
+void LoopbackTransport_ResetStats(void);
+
+#endif /* __TRANSPORT_H__ */
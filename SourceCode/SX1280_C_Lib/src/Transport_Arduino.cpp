@@ -0,0 +1,103 @@
+#ifdef ARDUINO
+
+#include "Config.h"
+#include "Transport.h"
+#include "Arduino.h"
+#include "SPI.h"
+
+static bool ArduinoInit(void)
+{
+  pinMode(NSS, OUTPUT);
+  digitalWrite(NSS, HIGH);
+
+  pinMode(NRESET, OUTPUT);
+  digitalWrite(NRESET, HIGH);
+
+  pinMode(BUSY, INPUT);
+  pinMode(DIO1, INPUT);
+
+  SPI.begin();
+  return true;
+}
+
+static void ArduinoReset(void)
+{
+  // __disable_irq( );
+  //  delay(20);
+  digitalWrite(NRESET, LOW);
+  //  delay(50);
+  digitalWrite(NRESET, HIGH);
+  //  delay(20);
+  // __enable_irq( );
+}
+
+static void ArduinoTransfer(uint8_t *frame, uint16_t size)
+{
+  SPI.transfer(frame, size);
+}
+
+static void ArduinoChipSelect(bool select)
+{
+  digitalWrite(NSS, select ? LOW : HIGH);
+}
+
+static bool ArduinoReadBusy(void)
+{
+  return digitalRead(BUSY) == HIGH;
+}
+
+static uint8_t ArduinoReadDio(void)
+{
+  return (digitalRead(DIO3) << 3) | (digitalRead(DIO2) << 2) | (digitalRead(DIO1) << 1) | (digitalRead(BUSY) << 0);
+}
+
+static void ArduinoAttachIrq(RadioIrqHandler_t handler)
+{
+  attachInterrupt(digitalPinToInterrupt(DIO1), handler, RISING);
+}
+
+static bool ArduinoWaitForIrq(uint32_t timeout)
+{
+  uint32_t start = millis();
+
+  // The handler itself is run by the DIO1 interrupt
+  while (digitalRead(DIO1) == LOW)
+  {
+    if ((uint32_t)(millis() - start) >= timeout)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static uint32_t ArduinoGetTime(void)
+{
+  return micros();
+}
+
+static void ArduinoYield(void)
+{
+  yield();
+}
+
+static void ArduinoSleep(uint32_t time)
+{
+  delayMicroseconds(time);
+}
+
+const RadioTransport_t ArduinoTransport = {
+  ArduinoInit,
+  ArduinoReset,
+  ArduinoTransfer,
+  ArduinoChipSelect,
+  ArduinoReadBusy,
+  ArduinoReadDio,
+  ArduinoAttachIrq,
+  ArduinoWaitForIrq,
+  ArduinoGetTime,
+  ArduinoYield,
+  ArduinoSleep
+};
+
+#endif /* ARDUINO */
@@ -0,0 +1,245 @@
+#if defined( __linux__ ) && !defined( ARDUINO )
+
+#include "Config.h"
+#include "Transport.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+#include <gpiod.h>
+
+#define LINUX_GPIO_CONSUMER                         "sx1280"
+
+static int __SpiFd = -1;
+static struct gpiod_chip *__GpioChip = NULL;
+static struct gpiod_line *__NssLine = NULL;
+static struct gpiod_line *__ResetLine = NULL;
+static struct gpiod_line *__BusyLine = NULL;
+static struct gpiod_line *__Dio1Line = NULL;
+static RadioIrqHandler_t __IrqHandler = NULL;
+
+static void LinuxDelayMs(uint32_t ms)
+{
+  usleep(ms * 1000);
+}
+
+/*!
+   \brief Releases the lines and the devices opened by LinuxInit( ), leaving
+   every handle NULL or -1
+*/
+static void LinuxRelease(void)
+{
+  struct gpiod_line **lines[] = { &__NssLine, &__ResetLine, &__BusyLine, &__Dio1Line };
+
+  for (uint8_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+  {
+    if (*lines[i] != NULL)
+    {
+      gpiod_line_release(*lines[i]);
+      *lines[i] = NULL;
+    }
+  }
+  if (__GpioChip != NULL)
+  {
+    gpiod_chip_close(__GpioChip);
+    __GpioChip = NULL;
+  }
+  if (__SpiFd >= 0)
+  {
+    close(__SpiFd);
+    __SpiFd = -1;
+  }
+}
+
+/*!
+   \brief Requests a GPIO line of the chip, as an output when value is 0 or
+   1, as an input when value is -1 and for rising edge events when -2
+
+   \retval      line          NULL on failure, after printing the error
+*/
+static struct gpiod_line *LinuxRequestLine(int offset, int value)
+{
+  struct gpiod_line *line = gpiod_chip_get_line(__GpioChip, offset);
+  int status = -1;
+
+  if (line != NULL)
+  {
+    if (value >= 0)
+    {
+      status = gpiod_line_request_output(line, LINUX_GPIO_CONSUMER, value);
+    }
+    else if (value == -1)
+    {
+      status = gpiod_line_request_input(line, LINUX_GPIO_CONSUMER);
+    }
+    else
+    {
+      status = gpiod_line_request_rising_edge_events(line, LINUX_GPIO_CONSUMER);
+    }
+  }
+  if (status < 0)
+  {
+    fprintf(stderr, "%s line %d: %s\n", LINUX_GPIO_CHIP, offset, strerror(errno));
+    return NULL;
+  }
+  return line;
+}
+
+static bool LinuxInit(void)
+{
+  uint8_t mode = SPI_MODE_0;
+  uint8_t bits = 8;
+  uint32_t speed = LINUX_SPI_SPEED;
+
+  LinuxRelease();
+  __SpiFd = open(LINUX_SPI_DEVICE, O_RDWR);
+  if (__SpiFd < 0)
+  {
+    perror(LINUX_SPI_DEVICE);
+    return false;
+  }
+  // NSS is driven as a GPIO so that it can stay low across a whole command
+  if (LINUX_GPIO_NSS >= 0)
+  {
+    mode |= SPI_NO_CS;
+  }
+  if ((ioctl(__SpiFd, SPI_IOC_WR_MODE, &mode) < 0) ||
+      (ioctl(__SpiFd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+      (ioctl(__SpiFd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0))
+  {
+    perror(LINUX_SPI_DEVICE);
+    LinuxRelease();
+    return false;
+  }
+
+  __GpioChip = gpiod_chip_open_by_name(LINUX_GPIO_CHIP);
+  if (__GpioChip == NULL)
+  {
+    perror(LINUX_GPIO_CHIP);
+    LinuxRelease();
+    return false;
+  }
+  if (LINUX_GPIO_NSS >= 0)
+  {
+    __NssLine = LinuxRequestLine(LINUX_GPIO_NSS, 1);
+  }
+  __ResetLine = LinuxRequestLine(LINUX_GPIO_NRESET, 1);
+  __BusyLine = LinuxRequestLine(LINUX_GPIO_BUSY, -1);
+  __Dio1Line = LinuxRequestLine(LINUX_GPIO_DIO1, -2);
+  if (((LINUX_GPIO_NSS >= 0) && (__NssLine == NULL)) || (__ResetLine == NULL) || (__BusyLine == NULL) || (__Dio1Line == NULL))
+  {
+    LinuxRelease();
+    return false;
+  }
+  return true;
+}
+
+static void LinuxReset(void)
+{
+  LinuxDelayMs(20);
+  gpiod_line_set_value(__ResetLine, 0);
+  LinuxDelayMs(50);
+  gpiod_line_set_value(__ResetLine, 1);
+  LinuxDelayMs(20);
+}
+
+static void LinuxTransfer(uint8_t *frame, uint16_t size)
+{
+  struct spi_ioc_transfer xfer;
+
+  memset(&xfer, 0, sizeof(xfer));
+  xfer.tx_buf = (unsigned long)frame;
+  xfer.rx_buf = (unsigned long)frame;
+  xfer.len = size;
+  xfer.speed_hz = LINUX_SPI_SPEED;
+  xfer.bits_per_word = 8;
+
+  if (ioctl(__SpiFd, SPI_IOC_MESSAGE(1), &xfer) < 0)
+  {
+    perror("SPI_IOC_MESSAGE");
+  }
+}
+
+static void LinuxChipSelect(bool select)
+{
+  // Without a NSS GPIO the kernel drives the hardware chip select per transfer
+  if (__NssLine != NULL)
+  {
+    gpiod_line_set_value(__NssLine, select ? 0 : 1);
+  }
+}
+
+static bool LinuxReadBusy(void)
+{
+  return gpiod_line_get_value(__BusyLine) == 1;
+}
+
+static uint8_t LinuxReadDio(void)
+{
+  return (gpiod_line_get_value(__Dio1Line) << 1) | (gpiod_line_get_value(__BusyLine) << 0);
+}
+
+static void LinuxAttachIrq(RadioIrqHandler_t handler)
+{
+  __IrqHandler = handler;
+}
+
+static bool LinuxWaitForIrq(uint32_t timeout)
+{
+  struct timespec ts;
+  struct gpiod_line_event event;
+
+  ts.tv_sec = timeout / 1000;
+  ts.tv_nsec = ( long )( timeout % 1000 ) * 1000000L;
+
+  if (gpiod_line_event_wait(__Dio1Line, &ts) != 1)
+  {
+    return false;
+  }
+  gpiod_line_event_read(__Dio1Line, &event);
+
+  if (__IrqHandler != NULL)
+  {
+    __IrqHandler();
+  }
+  return true;
+}
+
+static uint32_t LinuxGetTime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ( uint32_t )( ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000 );
+}
+
+static void LinuxYield(void)
+{
+  sched_yield();
+}
+
+static void LinuxSleep(uint32_t time)
+{
+  usleep(time);
+}
+
+const RadioTransport_t LinuxTransport = {
+  LinuxInit,
+  LinuxReset,
+  LinuxTransfer,
+  LinuxChipSelect,
+  LinuxReadBusy,
+  LinuxReadDio,
+  LinuxAttachIrq,
+  LinuxWaitForIrq,
+  LinuxGetTime,
+  LinuxYield,
+  LinuxSleep
+};
+
+#endif /* __linux__ && !ARDUINO */
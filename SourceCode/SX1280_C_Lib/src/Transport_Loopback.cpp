@@ -0,0 +1,151 @@
+#include "Transport.h"
+#include <string.h>
+
+/*!
+   \brief Largest frame recorded or answered by the loopback transport
+*/
+#define LOOPBACK_FRAME_SIZE                         259
+
+static uint8_t __LastFrame[LOOPBACK_FRAME_SIZE];
+static uint16_t __LastFrameSize = 0;
+static uint8_t __Response[LOOPBACK_FRAME_SIZE];
+static uint16_t __ResponseSize = 0;
+static volatile bool __Busy = false;
+static RadioIrqHandler_t __IrqHandler = NULL;
+static volatile bool __IrqPending = false;
+static LoopbackStats_t __Stats = { 0, 0 };
+static uint32_t __Time = 0;
+
+static bool LoopbackInit(void)
+{
+  __LastFrameSize = 0;
+  __ResponseSize = 0;
+  __Busy = false;
+  __IrqPending = false;
+  return true;
+}
+
+static void LoopbackReset(void)
+{
+  __Busy = false;
+}
+
+static void LoopbackTransfer(uint8_t *frame, uint16_t size)
+{
+  uint16_t recorded = ( size < LOOPBACK_FRAME_SIZE ) ? size : LOOPBACK_FRAME_SIZE;
+
+  memcpy(__LastFrame, frame, recorded);
+  __LastFrameSize = recorded;
+
+  // Answer with the queued response, or echo the frame when none is queued
+  if (__ResponseSize > 0)
+  {
+    for (uint16_t i = 0; i < size; i++)
+    {
+      frame[i] = ( i < __ResponseSize ) ? __Response[i] : 0;
+    }
+    __ResponseSize = 0;
+  }
+
+  __Stats.Transactions++;
+  __Stats.Bytes += size;
+}
+
+static void LoopbackChipSelect(bool select)
+{
+}
+
+static bool LoopbackReadBusy(void)
+{
+  return __Busy;
+}
+
+static uint8_t LoopbackReadDio(void)
+{
+  return (__IrqPending << 1) | (__Busy << 0);
+}
+
+static void LoopbackAttachIrq(RadioIrqHandler_t handler)
+{
+  __IrqHandler = handler;
+}
+
+static bool LoopbackWaitForIrq(uint32_t timeout)
+{
+  // Nothing runs concurrently: the IRQ is either already raised or never will
+  bool pending = __IrqPending;
+
+  __IrqPending = false;
+  return pending;
+}
+
+static uint32_t LoopbackGetTime(void)
+{
+  return __Time;
+}
+
+static void LoopbackYield(void)
+{
+}
+
+static void LoopbackSleep(uint32_t time)
+{
+  // Simulated time only moves forward when the driver sleeps
+  __Time += time;
+}
+
+void LoopbackTransport_SetResponse(const uint8_t *response, uint16_t size)
+{
+  __ResponseSize = ( size < LOOPBACK_FRAME_SIZE ) ? size : LOOPBACK_FRAME_SIZE;
+  memcpy(__Response, response, __ResponseSize);
+}
+
+const uint8_t *LoopbackTransport_GetLastFrame(uint16_t *size)
+{
+  *size = __LastFrameSize;
+  return __LastFrame;
+}
+
+void LoopbackTransport_SetBusy(bool busy)
+{
+  __Busy = busy;
+}
+
+void LoopbackTransport_RaiseIrq(void)
+{
+  __IrqPending = true;
+  if (__IrqHandler != NULL)
+  {
+    __IrqHandler();
+  }
+}
+
+void LoopbackTransport_SetTime(uint32_t time)
+{
+  __Time = time;
+}
+
+LoopbackStats_t LoopbackTransport_GetStats(void)
+{
+  return __Stats;
+}
+
+void LoopbackTransport_ResetStats(void)
+{
+  __Stats.Transactions = 0;
+  __Stats.Bytes = 0;
+}
+
+const RadioTransport_t LoopbackTransport = {
+  LoopbackInit,
+  LoopbackReset,
+  LoopbackTransfer,
+  LoopbackChipSelect,
+  LoopbackReadBusy,
+  LoopbackReadDio,
+  LoopbackAttachIrq,
+  LoopbackWaitForIrq,
+  LoopbackGetTime,
+  LoopbackYield,
+  LoopbackSleep
+};
@@ -0,0 +1,244 @@
+/*
+   Fits the ranging calibration and frequency error gradient tables of
+   RangingCalibration.h from logged calibration runs, and writes the new
+   header on the standard output. Cells without enough data keep their
+   current value.
+
+   The log holds one line per exchange, as printed by the Ranging sketch,
+   other lines being ignored:
+
+     RNG,<bandwidth kHz>,<SF>,<calibration>,<frequency error Hz>,<distance cm>[,<true distance cm>]
+
+   The frequency error of the log is the one the master reads on the
+   response. The tables use the one the slave measures on the request, as
+   the DevKit demo relays it, which is its opposite.
+
+   For each bandwidth and spreading factor, the error of the distance is
+   fitted by least squares as a + b * calibration + g * frequency error.
+   The calibration giving no error without frequency error is -a / b, it
+   needs runs at two calibrations at least, and g is the gradient.
+
+   Usage: RangingCalibFit [ true distance m ] < log > RangingCalibration.h
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Header.h"
+#include "RangingCalibration.h"
+
+static const uint16_t Bandwidths[RANGING_CALIBRATION_BW_COUNT] = { 400, 800, 1600 };
+static const char *BandwidthNames[RANGING_CALIBRATION_BW_COUNT] = { "LORA_BW_0400", "LORA_BW_0800", "LORA_BW_1600" };
+
+/*!
+   \brief Sums of a cell, the calibration and the frequency error centred
+   on their first sample to keep the sums small
+*/
+typedef struct
+{
+  uint32_t Count;
+  double Calibration0;
+  double Fei0;
+  double Sx, Sy, Se;                                      //!< Calibration, frequency error [kHz], distance error [m]
+  double Sxx, Syy, Sxy, Sxe, Sye, See;
+} Cell_t;
+
+static Cell_t Cells[RANGING_CALIBRATION_BW_COUNT][RANGING_CALIBRATION_SF_COUNT];
+
+static void CellAdd( Cell_t *cell, double calibration, double fei, double error )
+{
+  if ( cell->Count == 0 )
+  {
+    cell->Calibration0 = calibration;
+    cell->Fei0 = fei;
+  }
+  double x = calibration - cell->Calibration0;
+  double y = fei - cell->Fei0;
+
+  cell->Count++;
+  cell->Sx += x;
+  cell->Sy += y;
+  cell->Se += error;
+  cell->Sxx += x * x;
+  cell->Syy += y * y;
+  cell->Sxy += x * y;
+  cell->Sxe += x * error;
+  cell->Sye += y * error;
+  cell->See += error * error;
+}
+
+/*!
+   \brief Fits a cell, keeping the current calibration or gradient when the
+   runs do not vary the calibration or the frequency error
+
+   \retval      fitted        false when the cell has no sample
+*/
+static bool CellFit( const Cell_t *cell, uint16_t *calibration, int16_t *gradient, double *residual )
+{
+  double n = cell->Count;
+
+  if ( cell->Count == 0 )
+  {
+    return false;
+  }
+  // Centred second moments
+  double cxx = cell->Sxx - cell->Sx * cell->Sx / n;
+  double cyy = cell->Syy - cell->Sy * cell->Sy / n;
+  double cxy = cell->Sxy - cell->Sx * cell->Sy / n;
+  double cxe = cell->Sxe - cell->Sx * cell->Se / n;
+  double cye = cell->Sye - cell->Sy * cell->Se / n;
+  double cee = cell->See - cell->Se * cell->Se / n;
+  bool calibrationVaries = ( cxx > 1e-9 * n );
+  bool feiVaries = ( cyy > 1e-9 * n );
+  double b = 0.0;
+  double g = *gradient / 1000.0;
+  double explained = 0.0;
+
+  if ( calibrationVaries && feiVaries && ( fabs( cxx * cyy - cxy * cxy ) > 1e-12 * cxx * cyy ) )
+  {
+    double det = cxx * cyy - cxy * cxy;
+
+    b = ( cxe * cyy - cye * cxy ) / det;
+    g = ( cye * cxx - cxe * cxy ) / det;
+    explained = b * cxe + g * cye;
+  }
+  else if ( calibrationVaries )
+  {
+    b = cxe / cxx;
+    explained = b * cxe;
+  }
+  else if ( feiVaries )
+  {
+    g = cye / cyy;
+    explained = g * cye;
+  }
+  *residual = ( n > 1 ) ? sqrt( fmax( cee - explained, 0.0 ) / n ) : 0.0;
+
+  if ( calibrationVaries && ( fabs( b ) > 1e-9 ) )
+  {
+    // Error at the mean point, then the calibration cancelling it at 0 Hz
+    double meanCalibration = cell->Calibration0 + cell->Sx / n;
+    double meanFei = cell->Fei0 + cell->Sy / n;
+    double meanError = cell->Se / n - g * meanFei;
+    double fitted = meanCalibration - meanError / b;
+
+    *calibration = ( uint16_t )fmin( fmax( floor( fitted + 0.5 ), 0.0 ), 65535.0 );
+  }
+  *gradient = ( int16_t )fmin( fmax( floor( g * 1000.0 + 0.5 ), -32768.0 ), 32767.0 );
+  return true;
+}
+
+static void PrintTable( const char *type, const char *name, const char *brief, bool calibration,
+                        uint16_t calibrations[][RANGING_CALIBRATION_SF_COUNT], int16_t gradients[][RANGING_CALIBRATION_SF_COUNT] )
+{
+  printf( "/*!\n   \\brief %s\n                                                              SF5     SF6     SF7     SF8     SF9     SF10\n*/\n", brief );
+  printf( "static const %s %s[RANGING_CALIBRATION_BW_COUNT][RANGING_CALIBRATION_SF_COUNT] = {\n", type, name );
+  for ( uint8_t row = 0; row < RANGING_CALIBRATION_BW_COUNT; row++ )
+  {
+    char line[80] = "  {";
+
+    for ( uint8_t column = 0; column < RANGING_CALIBRATION_SF_COUNT; column++ )
+    {
+      char value[16];
+
+      snprintf( value, sizeof( value ), " %d%s", calibration ? calibrations[row][column] : gradients[row][column],
+                ( column + 1 < RANGING_CALIBRATION_SF_COUNT ) ? "," : "" );
+      snprintf( line + strlen( line ), sizeof( line ) - strlen( line ), "%-*s",
+                ( column + 1 < RANGING_CALIBRATION_SF_COUNT ) ? 8 : 7, value );
+    }
+    printf( "%s },     // %s\n", line, BandwidthNames[row] );
+  }
+  printf( "};\n\n" );
+}
+
+int main( int argc, char **argv )
+{
+  double trueDistance = ( argc > 1 ) ? atof( argv[1] ) * 100.0 : -1.0;
+  uint16_t calibrations[RANGING_CALIBRATION_BW_COUNT][RANGING_CALIBRATION_SF_COUNT];
+  int16_t gradients[RANGING_CALIBRATION_BW_COUNT][RANGING_CALIBRATION_SF_COUNT];
+  uint32_t lines = 0;
+  uint32_t samples = 0;
+  char line[256];
+
+  memcpy( calibrations, RangingCalibrations, sizeof( calibrations ) );
+  memcpy( gradients, RangingFeiGradients, sizeof( gradients ) );
+
+  while ( fgets( line, sizeof( line ), stdin ) != NULL )
+  {
+    const char *start = strstr( line, "RNG," );
+    unsigned bandwidth, sf, calibration;
+    long fei, distance, truth;
+    int fields;
+
+    lines++;
+    if ( start == NULL )
+    {
+      continue;
+    }
+    fields = sscanf( start, "RNG,%u,%u,%u,%ld,%ld,%ld", &bandwidth, &sf, &calibration, &fei, &distance, &truth );
+    if ( fields < 5 )
+    {
+      fprintf( stderr, "line %u: malformed, skipped\n", lines );
+      continue;
+    }
+    if ( fields < 6 )
+    {
+      if ( trueDistance < 0.0 )
+      {
+        fprintf( stderr, "line %u: no true distance, give it on the command line\n", lines );
+        return 1;
+      }
+      truth = ( long )floor( trueDistance + 0.5 );
+    }
+
+    uint8_t row = RANGING_CALIBRATION_BW_COUNT;
+    for ( uint8_t i = 0; i < RANGING_CALIBRATION_BW_COUNT; i++ )
+    {
+      row = ( Bandwidths[i] == bandwidth ) ? i : row;
+    }
+    if ( ( row >= RANGING_CALIBRATION_BW_COUNT ) || ( sf < 5 ) || ( sf >= 5 + RANGING_CALIBRATION_SF_COUNT ) )
+    {
+      fprintf( stderr, "line %u: BW %u kHz SF%u not in the tables, skipped\n", lines, bandwidth, sf );
+      continue;
+    }
+    // Frequency error of the slave, in the convention of the tables
+    CellAdd( &Cells[row][sf - 5], calibration, -fei / 1000.0, ( distance - truth ) / 100.0 );
+    samples++;
+  }
+
+  fprintf( stderr, "%u exchanges\n", samples );
+  for ( uint8_t row = 0; row < RANGING_CALIBRATION_BW_COUNT; row++ )
+  {
+    for ( uint8_t column = 0; column < RANGING_CALIBRATION_SF_COUNT; column++ )
+    {
+      double residual;
+
+      if ( CellFit( &Cells[row][column], &calibrations[row][column], &gradients[row][column], &residual ) == true )
+      {
+        fprintf( stderr, "BW %4u kHz SF%-2u: %5u exchanges, calibration %5u -> %5u, gradient %6d -> %6d mm/kHz, residual %.3f m\n",
+                 Bandwidths[row], column + 5, Cells[row][column].Count, RangingCalibrations[row][column], calibrations[row][column],
+                 RangingFeiGradients[row][column], gradients[row][column], residual );
+      }
+    }
+  }
+
+  printf( "/*\n   Ranging calibration of the SX1280 by LoRa bandwidth and spreading factor\n\n" );
+  printf( "   Generated by Simulator/RangingCalibFit, do not edit: log new calibration\n" );
+  printf( "   runs and run the generator again. Include after the radio header, which\n" );
+  printf( "   defines the LORA_BW_ and LORA_SF values.\n*/\n" );
+  printf( "#ifndef __RANGING_CALIBRATION_H__\n#define __RANGING_CALIBRATION_H__\n\n#include <stdint.h>\n\n" );
+  printf( "#define RANGING_CALIBRATION_BW_COUNT                %u\n", RANGING_CALIBRATION_BW_COUNT );
+  printf( "#define RANGING_CALIBRATION_SF_COUNT                %u\n\n", RANGING_CALIBRATION_SF_COUNT );
+  PrintTable( "uint16_t", "RangingCalibrations", "Ranging calibration register values", true, calibrations, gradients );
+  PrintTable( "int16_t", "RangingFeiGradients", "Distance error per frequency error [mm/kHz], subtracted from the\n"
+              "   raw distance times the frequency error the slave measures on the\n"
+              "   master's request, as the DevKit demo relays it", false, calibrations, gradients );
+  printf( "/*!\n   \\brief Row of the tables for a bandwidth, RANGING_CALIBRATION_BW_COUNT\n   when it is not calibrated\n*/\n" );
+  printf( "static inline uint8_t RangingCalibrationRow( uint8_t bandwidth )\n{\n" );
+  printf( "  return ( bandwidth == LORA_BW_0400 ) ? 0 : ( bandwidth == LORA_BW_0800 ) ? 1 : ( bandwidth == LORA_BW_1600 ) ? 2 : RANGING_CALIBRATION_BW_COUNT;\n}\n\n" );
+  printf( "/*!\n   \\brief Column of the tables for a spreading factor,\n   RANGING_CALIBRATION_SF_COUNT when it is not calibrated\n*/\n" );
+  printf( "static inline uint8_t RangingCalibrationColumn( uint8_t spreadingFactor )\n{\n" );
+  printf( "  return ( ( spreadingFactor >= LORA_SF5 ) && ( spreadingFactor <= LORA_SF10 ) ) ? ( spreadingFactor >> 4 ) - 5 : RANGING_CALIBRATION_SF_COUNT;\n}\n\n" );
+  printf( "#endif /* __RANGING_CALIBRATION_H__ */\n" );
+  return 0;
+}
@@ -0,0 +1,875 @@
+#include "SX1280Sim.h"
+#include <string.h>
+#include <math.h>
+
+/*!
+   \brief Durations the BUSY line stays high [us]
+*/
+#define SIM_WAKEUP_TIME                             1200    // Boot after reset or wake up from sleep
+#define SIM_COMMAND_TIME                            2       // Configuration commands
+#define SIM_FS_TIME                                 54      // Standby to frequency synthesis
+#define SIM_RXTX_TIME                               20      // Frequency synthesis to RX or TX
+#define SIM_CALIBRATION_TIME                        800
+
+/*!
+   \brief Time between the end of a ranging request and the start of the
+   slave response, and extra time the master listens for it [us]
+*/
+#define SIM_RANGING_TURNAROUND                      500
+#define SIM_RANGING_MARGIN                          1000
+
+/*!
+   \brief Received power model: free space loss at 1 m at 2.4 GHz [dB] and
+   noise figure of the receiver [dB]
+*/
+#define SIM_PATH_LOSS_1M                            40.0
+#define SIM_NOISE_FIGURE                            6.0
+
+/*!
+   \brief Bitrates [kb/s] indexed by the 3 MSB of the bitrate and bandwidth
+   modulation parameter
+*/
+static const uint16_t SimGfskBitrates[] = { 2000, 1600, 1000, 800, 500, 400, 250, 125 };
+static const uint16_t SimFlrcBitrates[] = { 1300, 1300, 1300, 1040, 650, 520, 325, 260 };
+
+SX1280Sim::SX1280Sim( SimChannel *channel ) :
+  Channel( channel ), Dio1Handler( NULL ), FrequencyOffset( 0 ), RangingBias( 0.0 ), RangingDeviation( 0.0 ),
+  RangingFeiGradient( 0.0 )
+{
+  Position[0] = 0.0;
+  Position[1] = 0.0;
+  Position[2] = 0.0;
+  Channel->Attach( this );
+  Reset( );
+}
+
+void SX1280Sim::Reset( void )
+{
+  OperatingMode = MODE_STDBY_RC;
+  PacketType = PACKET_TYPE_GFSK;
+  Frequency = 0;
+  memset( ModulationParams, 0, sizeof( ModulationParams ) );
+  memset( PacketParams, 0, sizeof( PacketParams ) );
+  TxPower = 0;
+  CadSymbols = 1;
+  TxBaseAddress = 0;
+  RxBaseAddress = 0;
+  RangingRole = RADIO_RANGING_ROLE_SLAVE;
+  AutoFs = false;
+
+  memset( Buffer, 0, sizeof( Buffer ) );
+  memset( Registers, 0, sizeof( Registers ) );
+  Registers[REG_LR_FIRMWARE_VERSION_MSB] = 0xA9;
+  Registers[REG_LR_FIRMWARE_VERSION_MSB + 1] = 0xB5;
+  RxPayloadLength = 0;
+  RxStartBufferPointer = 0;
+  memset( PacketStatus, 0, sizeof( PacketStatus ) );
+
+  IrqStatus = 0;
+  IrqMask = 0;
+  DioMask[0] = 0;
+  DioMask[1] = 0;
+  DioMask[2] = 0;
+  Dio1Level = false;
+
+  BusyUntil = Channel->Now( ) + SIM_WAKEUP_TIME;
+  TxEndAt = SIM_NEVER;
+  TimeoutAt = SIM_NEVER;
+  CadEndAt = SIM_NEVER;
+  ResponseAt = SIM_NEVER;
+  RxContinuous = false;
+  RangingWait = false;
+  LockedFrame = 0;
+  IgnoredCommands = 0;
+
+  RangingSum = 0.0;
+  RangingCount = 0;
+  RangingRaw = 0;
+  RangingFiltered = 0;
+}
+
+void SX1280Sim::Transfer( uint8_t *frame, uint16_t size )
+{
+  uint64_t now = Channel->Now( );
+  uint8_t params[259];
+  uint16_t count = ( size > 0 ) ? size - 1 : 0;
+  uint8_t opcode;
+  uint32_t busy = SIM_COMMAND_TIME;
+
+  if ( size == 0 )
+  {
+    return;
+  }
+  opcode = frame[0];
+  memcpy( params, &frame[1], ( count < sizeof( params ) ) ? count : sizeof( params ) );
+
+  // The NSS falling edge wakes the chip up, the frame itself is lost
+  if ( OperatingMode == MODE_SLEEP )
+  {
+    OperatingMode = MODE_STDBY_RC;
+    BusyUntil = now + SIM_WAKEUP_TIME;
+    memset( frame, GetStatusByte( ), size );
+    return;
+  }
+
+  // Every byte not carrying data returns the status
+  memset( frame, GetStatusByte( ), size );
+
+  // GetStatus is the only command served while BUSY is high
+  if ( opcode == RADIO_GET_STATUS )
+  {
+    return;
+  }
+  if ( now < BusyUntil )
+  {
+    IgnoredCommands++;
+    return;
+  }
+
+  switch ( opcode )
+  {
+    case RADIO_WRITE_REGISTER:
+      for ( uint16_t i = 2; i < count; i++ )
+      {
+        WriteRegister( ( ( params[0] << 8 ) | params[1] ) + i - 2, params[i] );
+      }
+      break;
+
+    case RADIO_READ_REGISTER:
+      for ( uint16_t i = 4; i < size; i++ )
+      {
+        frame[i] = ReadRegister( ( ( params[0] << 8 ) | params[1] ) + i - 4 );
+      }
+      break;
+
+    case RADIO_WRITE_BUFFER:
+      for ( uint16_t i = 1; i < count; i++ )
+      {
+        Buffer[( uint8_t )( params[0] + i - 1 )] = params[i];
+      }
+      break;
+
+    case RADIO_READ_BUFFER:
+      for ( uint16_t i = 3; i < size; i++ )
+      {
+        frame[i] = Buffer[( uint8_t )( params[0] + i - 3 )];
+      }
+      break;
+
+    case RADIO_SET_SLEEP:
+      Abort( );
+      OperatingMode = MODE_SLEEP;
+      break;
+
+    case RADIO_SET_STANDBY:
+      Abort( );
+      OperatingMode = ( params[0] == STDBY_XOSC ) ? MODE_STDBY_XOSC : MODE_STDBY_RC;
+      break;
+
+    case RADIO_SET_FS:
+      busy = ( OperatingMode == MODE_FS ) ? SIM_COMMAND_TIME : SIM_FS_TIME;
+      Abort( );
+      OperatingMode = MODE_FS;
+      break;
+
+    case RADIO_SET_TX:
+      busy = ( OperatingMode == MODE_FS ) ? SIM_RXTX_TIME : SIM_FS_TIME + SIM_RXTX_TIME;
+      Abort( );
+      if ( ( PacketType == PACKET_TYPE_RANGING ) && ( RangingRole == RADIO_RANGING_ROLE_MASTER ) )
+      {
+        StartTx( now + busy, SIM_FRAME_RANGING_REQUEST, 0 );
+      }
+      else
+      {
+        StartTx( now + busy, SIM_FRAME_DATA, GetTickTime( params ) );
+      }
+      break;
+
+    case RADIO_SET_RX:
+    case RADIO_SET_RXDUTYCYCLE:
+      busy = ( OperatingMode == MODE_FS ) ? SIM_RXTX_TIME : SIM_FS_TIME + SIM_RXTX_TIME;
+      Abort( );
+      OperatingMode = MODE_RX;
+      // The duty cycled reception is modelled as a continuous one
+      RxContinuous = ( opcode == RADIO_SET_RXDUTYCYCLE ) || ( ( ( params[1] << 8 ) | params[2] ) == 0xFFFF );
+      if ( ( RxContinuous == false ) && ( GetTickTime( params ) != 0 ) )
+      {
+        TimeoutAt = now + busy + GetTickTime( params );
+      }
+      break;
+
+    case RADIO_SET_CAD:
+      busy = ( OperatingMode == MODE_FS ) ? SIM_RXTX_TIME : SIM_FS_TIME + SIM_RXTX_TIME;
+      Abort( );
+      OperatingMode = MODE_CAD;
+      CadEndAt = now + busy + ( uint64_t )CadSymbols * GetSymbolTime( );
+      break;
+
+    case RADIO_SET_TXCONTINUOUSWAVE:
+    case RADIO_SET_TXCONTINUOUSPREAMBLE:
+      busy = ( OperatingMode == MODE_FS ) ? SIM_RXTX_TIME : SIM_FS_TIME + SIM_RXTX_TIME;
+      Abort( );
+      OperatingMode = MODE_TX;
+      break;
+
+    case RADIO_SET_PACKETTYPE:
+      PacketType = ( RadioPacketTypes_t )params[0];
+      break;
+
+    case RADIO_GET_PACKETTYPE:
+      if ( size > 2 )
+      {
+        frame[2] = PacketType;
+      }
+      break;
+
+    case RADIO_SET_RFFREQUENCY:
+      Frequency = ( params[0] << 16 ) | ( params[1] << 8 ) | params[2];
+      break;
+
+    case RADIO_SET_TXPARAMS:
+      TxPower = ( int8_t )( params[0] - 18 );
+      break;
+
+    case RADIO_SET_CADPARAMS:
+      CadSymbols = 1 << ( params[0] >> 5 );
+      break;
+
+    case RADIO_SET_BUFFERBASEADDRESS:
+      TxBaseAddress = params[0];
+      RxBaseAddress = params[1];
+      break;
+
+    case RADIO_SET_MODULATIONPARAMS:
+      memcpy( ModulationParams, params, sizeof( ModulationParams ) );
+      break;
+
+    case RADIO_SET_PACKETPARAMS:
+      memcpy( PacketParams, params, sizeof( PacketParams ) );
+      // The LoRa header type and payload length are mirrored in registers
+      if ( ( PacketType == PACKET_TYPE_LORA ) || ( PacketType == PACKET_TYPE_RANGING ) )
+      {
+        Registers[REG_LR_PACKETPARAMS] = ( Registers[REG_LR_PACKETPARAMS] & 0x7F ) | ( PacketParams[1] & 0x80 );
+        Registers[REG_LR_PAYLOADLENGTH] = PacketParams[2];
+      }
+      break;
+
+    case RADIO_GET_RXBUFFERSTATUS:
+      if ( size > 3 )
+      {
+        frame[2] = ( PacketType == PACKET_TYPE_BLE ) ? RxPayloadLength - 2 : RxPayloadLength;
+        frame[3] = RxStartBufferPointer;
+      }
+      break;
+
+    case RADIO_GET_PACKETSTATUS:
+      for ( uint16_t i = 2; ( i < size ) && ( i < 7 ); i++ )
+      {
+        frame[i] = PacketStatus[i - 2];
+      }
+      break;
+
+    case RADIO_GET_RSSIINST:
+      if ( size > 2 )
+      {
+        frame[2] = Channel->IsOccupied( this, Frequency, now ) ? 120 : 200;
+      }
+      break;
+
+    case RADIO_SET_DIOIRQPARAMS:
+      IrqMask = ( params[0] << 8 ) | params[1];
+      DioMask[0] = ( params[2] << 8 ) | params[3];
+      DioMask[1] = ( params[4] << 8 ) | params[5];
+      DioMask[2] = ( params[6] << 8 ) | params[7];
+      UpdateDio1( );
+      break;
+
+    case RADIO_GET_IRQSTATUS:
+      if ( size > 3 )
+      {
+        frame[2] = ( IrqStatus >> 8 ) & 0xFF;
+        frame[3] = IrqStatus & 0xFF;
+      }
+      break;
+
+    case RADIO_CLR_IRQSTATUS:
+      ClearIrqStatus( ( params[0] << 8 ) | params[1] );
+      break;
+
+    case RADIO_CALIBRATE:
+      busy = SIM_CALIBRATION_TIME;
+      break;
+
+    case RADIO_SET_AUTOFS:
+      AutoFs = ( params[0] != 0 );
+      break;
+
+    case RADIO_SET_RANGING_ROLE:
+      RangingRole = params[0];
+      break;
+
+    case RADIO_SET_REGULATORMODE:
+    case RADIO_SET_SAVECONTEXT:
+    case RADIO_SET_AUTOTX:
+    case RADIO_SET_LONGPREAMBLE:
+    case RADIO_SET_UARTSPEED:
+      break;
+
+    default:
+      IgnoredCommands++;
+      return;
+  }
+  BusyUntil = now + busy;
+}
+
+bool SX1280Sim::GetBusy( void ) const
+{
+  return ( OperatingMode == MODE_SLEEP ) || ( Channel->Now( ) < BusyUntil );
+}
+
+uint64_t SX1280Sim::GetBusyUntil( void ) const
+{
+  return BusyUntil;
+}
+
+uint8_t SX1280Sim::GetDio( void ) const
+{
+  return ( ( ( IrqStatus & DioMask[2] ) != 0 ) << 3 ) | ( ( ( IrqStatus & DioMask[1] ) != 0 ) << 2 ) |
+         ( Dio1Level << 1 ) | ( GetBusy( ) << 0 );
+}
+
+void SX1280Sim::SetDio1Handler( void ( *handler )( void ) )
+{
+  Dio1Handler = handler;
+}
+
+void SX1280Sim::SetPosition( double x, double y, double z )
+{
+  Position[0] = x;
+  Position[1] = y;
+  Position[2] = z;
+}
+
+double SX1280Sim::GetDistance( const SX1280Sim *other ) const
+{
+  double dx = Position[0] - other->Position[0];
+  double dy = Position[1] - other->Position[1];
+  double dz = Position[2] - other->Position[2];
+
+  return sqrt( dx * dx + dy * dy + dz * dz );
+}
+
+void SX1280Sim::SetFrequencyOffset( int32_t offset )
+{
+  FrequencyOffset = offset;
+}
+
+void SX1280Sim::SetRangingError( double bias, double deviation )
+{
+  RangingBias = bias;
+  RangingDeviation = deviation;
+}
+
+void SX1280Sim::SetRangingFeiGradient( double gradient )
+{
+  RangingFeiGradient = gradient;
+}
+
+void SX1280Sim::Command( RadioCommands_t opcode, const uint8_t *params, uint16_t size )
+{
+  uint8_t frame[259];
+
+  if ( OperatingMode != MODE_SLEEP )
+  {
+    Channel->RunUntil( BusyUntil );
+  }
+  frame[0] = opcode;
+  memcpy( &frame[1], params, size );
+  Transfer( frame, size + 1 );
+}
+
+RadioOperatingModes_t SX1280Sim::GetOperatingMode( void ) const
+{
+  return OperatingMode;
+}
+
+uint16_t SX1280Sim::GetIrqStatus( void ) const
+{
+  return IrqStatus;
+}
+
+void SX1280Sim::ClearIrqStatus( uint16_t irq )
+{
+  IrqStatus &= ~irq;
+  UpdateDio1( );
+}
+
+const uint8_t *SX1280Sim::GetBuffer( void ) const
+{
+  return Buffer;
+}
+
+uint8_t SX1280Sim::GetRxPayloadLength( void ) const
+{
+  return RxPayloadLength;
+}
+
+uint8_t SX1280Sim::GetRxStartBufferPointer( void ) const
+{
+  return RxStartBufferPointer;
+}
+
+uint8_t SX1280Sim::GetRegister( uint16_t address ) const
+{
+  return ReadRegister( address );
+}
+
+void SX1280Sim::SetRegister( uint16_t address, uint8_t value )
+{
+  WriteRegister( address, value );
+}
+
+uint32_t SX1280Sim::GetIgnoredCommands( void ) const
+{
+  return IgnoredCommands;
+}
+
+uint64_t SX1280Sim::GetNextEvent( void ) const
+{
+  uint64_t next = TxEndAt;
+
+  next = ( TimeoutAt < next ) ? TimeoutAt : next;
+  next = ( CadEndAt < next ) ? CadEndAt : next;
+  next = ( ResponseAt < next ) ? ResponseAt : next;
+  return next;
+}
+
+void SX1280Sim::Update( uint64_t now )
+{
+  if ( ResponseAt <= now )
+  {
+    ResponseAt = SIM_NEVER;
+    StartTx( now, SIM_FRAME_RANGING_RESPONSE, 0 );
+  }
+  if ( TxEndAt <= now )
+  {
+    TxEndAt = SIM_NEVER;
+    OnTxEnd( );
+  }
+  if ( CadEndAt <= now )
+  {
+    bool detected = Channel->IsOccupied( this, Frequency, now );
+
+    CadEndAt = SIM_NEVER;
+    EndOperation( false );
+    RaiseIrq( IRQ_CAD_DONE | ( detected ? IRQ_CAD_DETECTED : 0 ) );
+  }
+  if ( TimeoutAt <= now )
+  {
+    bool ranging = RangingWait;
+
+    TimeoutAt = SIM_NEVER;
+    EndOperation( false );
+    RaiseIrq( ranging ? IRQ_RANGING_MASTER_TIMEOUT : IRQ_RX_TX_TIMEOUT );
+  }
+}
+
+void SX1280Sim::OnFrameStart( uint32_t id, const SimFrame_t &frame )
+{
+  if ( IsListening( frame ) == false )
+  {
+    return;
+  }
+  LockedFrame = id;
+  // The single reception timeout stops once a preamble is detected
+  if ( RangingWait == false )
+  {
+    TimeoutAt = SIM_NEVER;
+  }
+  RaiseIrq( IRQ_PREAMBLE_DETECTED );
+}
+
+void SX1280Sim::OnFrameEnd( uint32_t id, const SimFrame_t &frame, bool corrupted )
+{
+  double distance = GetDistance( frame.Source );
+  double rssi = frame.Power - SIM_PATH_LOSS_1M - 20.0 * log10( ( distance > 1.0 ) ? distance : 1.0 );
+  double snr = rssi - ( -174.0 + 10.0 * log10( ( double )GetBandwidth( ) ) + SIM_NOISE_FIGURE );
+  double efe = ( double )( frame.Source->FrequencyOffset - FrequencyOffset ) * ( 1600.0 / GetBandwidth( ) * 1000.0 ) / 1.55;
+  uint32_t efeCode = ( uint32_t )( int32_t )lround( efe ) & REG_LR_ESTIMATED_FREQUENCY_ERROR_MASK;
+  uint16_t irq = IRQ_RX_DONE;
+
+  if ( id != LockedFrame )
+  {
+    return;
+  }
+  LockedFrame = 0;
+
+  rssi = ( rssi > 0.0 ) ? 0.0 : ( ( rssi < -127.0 ) ? -127.0 : rssi );
+  snr = ( snr > 31.0 ) ? 31.0 : ( ( snr < -32.0 ) ? -32.0 : snr );
+  memset( PacketStatus, 0, sizeof( PacketStatus ) );
+  if ( ( PacketType == PACKET_TYPE_LORA ) || ( PacketType == PACKET_TYPE_RANGING ) )
+  {
+    PacketStatus[0] = ( uint8_t )( -rssi * 2.0 );
+    PacketStatus[1] = ( uint8_t )( int8_t )( snr * 4.0 );
+    irq |= IRQ_HEADER_VALID;
+  }
+  else
+  {
+    PacketStatus[1] = ( uint8_t )( -rssi * 2.0 );
+    PacketStatus[2] = ( corrupted ? 0x10 : 0x00 ) | 0x04 | 0x02;
+    irq |= IRQ_SYNCWORD_VALID;
+  }
+  Registers[REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB] = ( efeCode >> 16 ) & 0xFF;
+  Registers[REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB + 1] = ( efeCode >> 8 ) & 0xFF;
+  Registers[REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB + 2] = efeCode & 0xFF;
+
+  switch ( frame.Kind )
+  {
+    case SIM_FRAME_DATA:
+      for ( uint16_t i = 0; i < frame.Size; i++ )
+      {
+        Buffer[( uint8_t )( RxBaseAddress + i )] = frame.Payload[i];
+      }
+      RxPayloadLength = frame.Size;
+      RxStartBufferPointer = RxBaseAddress;
+      EndOperation( RxContinuous );
+      RaiseIrq( irq | ( corrupted ? IRQ_CRC_ERROR : 0 ) );
+      break;
+
+    case SIM_FRAME_RANGING_REQUEST:
+      if ( ( corrupted == false ) && ( frame.Address == GetRangingAddress( REG_LR_DEVICERANGINGADDR ) ) )
+      {
+        ResponseAt = Channel->Now( ) + SIM_RANGING_TURNAROUND;
+        OperatingMode = MODE_FS;
+        RaiseIrq( IRQ_RANGING_SLAVE_REQUEST_VALID );
+      }
+      else
+      {
+        EndOperation( RxContinuous );
+        RaiseIrq( IRQ_RANGING_SLAVE_REQUEST_DISCARDED );
+      }
+      break;
+
+    case SIM_FRAME_RANGING_RESPONSE:
+      // A corrupted response is missed, the master then times out
+      if ( corrupted == false )
+      {
+        OnRangingResult( frame );
+        TimeoutAt = SIM_NEVER;
+        EndOperation( false );
+        RaiseIrq( IRQ_RANGING_MASTER_RESULT_VALID );
+      }
+      break;
+  }
+}
+
+uint8_t SX1280Sim::GetStatusByte( void ) const
+{
+  uint8_t chipMode;
+
+  switch ( OperatingMode )
+  {
+    case MODE_STDBY_XOSC:
+      chipMode = 0x3;
+      break;
+    case MODE_FS:
+      chipMode = 0x4;
+      break;
+    case MODE_RX:
+    case MODE_CAD:
+      chipMode = 0x5;
+      break;
+    case MODE_TX:
+      chipMode = 0x6;
+      break;
+    default:
+      chipMode = 0x2;
+      break;
+  }
+  // Command status 0x1: command successfully processed
+  return ( chipMode << 5 ) | ( 0x1 << 2 );
+}
+
+uint8_t SX1280Sim::ReadRegister( uint16_t address ) const
+{
+  if ( ( address >= REG_LR_RANGINGRESULTBASEADDR ) && ( address < REG_LR_RANGINGRESULTBASEADDR + 3 ) )
+  {
+    // The result multiplexer selects the raw or the filtered result
+    uint32_t result = ( ( Registers[REG_LR_RANGINGRESULTCONFIG] >> 4 ) & 0x03 ) ? RangingFiltered : RangingRaw;
+
+    return ( result >> ( 8 * ( REG_LR_RANGINGRESULTBASEADDR + 2 - address ) ) ) & 0xFF;
+  }
+  return Registers[address];
+}
+
+void SX1280Sim::WriteRegister( uint16_t address, uint8_t value )
+{
+  Registers[address] = value;
+  if ( ( address == REG_LR_RANGINGRESULTCLEARREG ) && ( ( value & ( 1 << 5 ) ) != 0 ) )
+  {
+    RangingSum = 0.0;
+    RangingCount = 0;
+  }
+}
+
+void SX1280Sim::RaiseIrq( uint16_t irq )
+{
+  IrqStatus |= irq & IrqMask;
+  UpdateDio1( );
+}
+
+void SX1280Sim::UpdateDio1( void )
+{
+  bool level = ( IrqStatus & DioMask[0] ) != 0;
+  bool rising = ( level == true ) && ( Dio1Level == false );
+
+  Dio1Level = level;
+  if ( ( rising == true ) && ( Dio1Handler != NULL ) )
+  {
+    Dio1Handler( );
+  }
+}
+
+void SX1280Sim::EndOperation( bool stayInRx )
+{
+  LockedFrame = 0;
+  RangingWait = false;
+  if ( stayInRx == true )
+  {
+    OperatingMode = MODE_RX;
+  }
+  else
+  {
+    OperatingMode = AutoFs ? MODE_FS : MODE_STDBY_RC;
+    RxContinuous = false;
+  }
+}
+
+void SX1280Sim::Abort( void )
+{
+  EndOperation( false );
+  TxEndAt = SIM_NEVER;
+  TimeoutAt = SIM_NEVER;
+  CadEndAt = SIM_NEVER;
+  ResponseAt = SIM_NEVER;
+}
+
+uint32_t SX1280Sim::GetBandwidth( void ) const
+{
+  switch ( ModulationParams[1] )
+  {
+    case LORA_BW_0200:
+      return 203125;
+    case LORA_BW_0400:
+      return 406250;
+    case LORA_BW_0800:
+      return 812500;
+    default:
+      return 1625000;
+  }
+}
+
+uint32_t SX1280Sim::GetSymbolTime( void ) const
+{
+  uint8_t sf = ModulationParams[0] >> 4;
+
+  return ( uint32_t )( ( ( uint64_t )1000000 << sf ) / GetBandwidth( ) );
+}
+
+uint32_t SX1280Sim::GetTimeOnAir( uint8_t size ) const
+{
+  double bits = 0.0;
+  uint16_t bitrate;
+
+  switch ( PacketType )
+  {
+    case PACKET_TYPE_LORA:
+    case PACKET_TYPE_RANGING:
+    {
+      // Semtech LoRa time on air formula, without low data rate optimisation
+      uint8_t sf = ModulationParams[0] >> 4;
+      uint8_t cr = ModulationParams[2];
+      double symbols = ( PacketParams[0] & 0x0F ) << ( PacketParams[0] >> 4 );
+      double payloadBits = 8.0 * size - 4.0 * sf + ( ( sf >= 7 ) ? 8.0 : 0.0 ) +
+                           ( ( PacketParams[3] == LORA_CRC_ON ) ? 16.0 : 0.0 ) +
+                           ( ( PacketParams[1] == LORA_PACKET_IMPLICIT ) ? 0.0 : 20.0 );
+
+      // Long interleaved coding rates 4/5, 4/6 and 4/8
+      cr = ( cr == LORA_CR_LI_4_5 ) ? 1 : ( cr == LORA_CR_LI_4_6 ) ? 2 : ( cr == LORA_CR_LI_4_7 ) ? 4 : cr;
+      symbols += ( ( sf < 7 ) ? 6.25 : 4.25 ) + 8.0;
+      if ( payloadBits > 0.0 )
+      {
+        symbols += ceil( payloadBits / ( 4.0 * sf ) ) * ( cr + 4 );
+      }
+      return ( uint32_t )( symbols * ( ( double )( 1UL << sf ) * 1e6 / GetBandwidth( ) ) );
+    }
+
+    case PACKET_TYPE_FLRC:
+      bitrate = SimFlrcBitrates[ModulationParams[0] >> 5];
+      bits = ( ( PacketParams[0] >> 4 ) + 1 ) * 4 + 32 + 16 + ( size + ( PacketParams[5] >> 4 ) ) * 8.0 *
+             ( ( ModulationParams[1] == FLRC_CR_1_2 ) ? 2.0 : ( ModulationParams[1] == FLRC_CR_3_4 ) ? 4.0 / 3.0 : 1.0 );
+      break;
+
+    case PACKET_TYPE_BLE:
+      bitrate = 1000;
+      bits = 8 + 32 + 16 + size * 8.0 + 24;
+      break;
+
+    default:
+      bitrate = SimGfskBitrates[ModulationParams[0] >> 5];
+      bits = ( ( PacketParams[0] >> 4 ) + 1 ) * 4 + ( ( PacketParams[1] >> 1 ) + 1 ) * 8 +
+             ( ( PacketParams[3] != 0 ) ? 8 : 0 ) + ( size + ( PacketParams[5] >> 4 ) ) * 8.0;
+      break;
+  }
+  return ( uint32_t )( bits * 1000.0 / bitrate );
+}
+
+uint32_t SX1280Sim::GetTickTime( const uint8_t *timeout ) const
+{
+  static const uint32_t step[] = { 15625, 62500, 1000000, 4000000 };   // [ns]
+  uint32_t count = ( timeout[1] << 8 ) | timeout[2];
+
+  return ( uint32_t )( ( ( uint64_t )count * step[timeout[0] & 0x03] ) / 1000 );
+}
+
+uint8_t SX1280Sim::GetRangingIdLength( void ) const
+{
+  return ( ( Registers[REG_LR_RANGINGIDCHECKLENGTH] >> 6 ) & 0x03 ) + 1;
+}
+
+uint32_t SX1280Sim::GetRangingAddress( uint16_t address ) const
+{
+  uint32_t value = ( Registers[address] << 24 ) | ( Registers[address + 1] << 16 ) |
+                   ( Registers[address + 2] << 8 ) | Registers[address + 3];
+  uint8_t length = GetRangingIdLength( );
+
+  // Only the ID check length LSBs of the addresses are compared
+  return ( length == 4 ) ? value : ( value & ( ( 1UL << ( 8 * length ) ) - 1 ) );
+}
+
+bool SX1280Sim::IsListening( const SimFrame_t &frame ) const
+{
+  if ( ( OperatingMode != MODE_RX ) || ( LockedFrame != 0 ) )
+  {
+    return false;
+  }
+  if ( ( frame.PacketType != PacketType ) || ( frame.Frequency != Frequency ) )
+  {
+    return false;
+  }
+  if ( ( PacketType == PACKET_TYPE_LORA ) || ( PacketType == PACKET_TYPE_RANGING ) )
+  {
+    if ( ( frame.ModulationParams[0] != ModulationParams[0] ) || ( frame.ModulationParams[1] != ModulationParams[1] ) )
+    {
+      return false;
+    }
+  }
+  else if ( frame.ModulationParams[0] != ModulationParams[0] )
+  {
+    return false;
+  }
+
+  if ( PacketType == PACKET_TYPE_RANGING )
+  {
+    if ( RangingWait == true )
+    {
+      return ( frame.Kind == SIM_FRAME_RANGING_RESPONSE ) && ( frame.Address == GetRangingAddress( REG_LR_REQUESTRANGINGADDR ) );
+    }
+    return ( RangingRole == RADIO_RANGING_ROLE_SLAVE ) && ( frame.Kind == SIM_FRAME_RANGING_REQUEST );
+  }
+  return frame.Kind == SIM_FRAME_DATA;
+}
+
+void SX1280Sim::StartTx( uint64_t start, SimFrameKinds_t kind, uint32_t timeout )
+{
+  uint8_t size;
+
+  TxFrame.Source = this;
+  TxFrame.Kind = kind;
+  TxFrame.PacketType = PacketType;
+  TxFrame.Frequency = Frequency;
+  memcpy( TxFrame.ModulationParams, ModulationParams, sizeof( ModulationParams ) );
+  TxFrame.Power = TxPower;
+  TxFrame.Address = 0;
+
+  switch ( kind )
+  {
+    case SIM_FRAME_RANGING_REQUEST:
+      TxFrame.Address = GetRangingAddress( REG_LR_REQUESTRANGINGADDR );
+      size = GetRangingIdLength( );
+      break;
+    case SIM_FRAME_RANGING_RESPONSE:
+      TxFrame.Address = GetRangingAddress( REG_LR_DEVICERANGINGADDR );
+      size = GetRangingIdLength( );
+      break;
+    default:
+      if ( PacketType == PACKET_TYPE_BLE )
+      {
+        size = Buffer[( uint8_t )( TxBaseAddress + 1 )] + 2;
+      }
+      else if ( ( PacketType == PACKET_TYPE_LORA ) || ( PacketType == PACKET_TYPE_RANGING ) )
+      {
+        size = PacketParams[2];
+      }
+      else
+      {
+        size = PacketParams[4];
+      }
+      break;
+  }
+  TxFrame.Size = size;
+  for ( uint16_t i = 0; i < size; i++ )
+  {
+    TxFrame.Payload[i] = Buffer[( uint8_t )( TxBaseAddress + i )];
+  }
+
+  OperatingMode = MODE_TX;
+  // A frame longer than the timeout is never completed
+  if ( ( timeout != 0 ) && ( timeout < GetTimeOnAir( size ) ) )
+  {
+    TimeoutAt = start + timeout;
+    return;
+  }
+  TxEndAt = start + GetTimeOnAir( size );
+  Channel->Transmit( TxFrame, start, TxEndAt );
+}
+
+void SX1280Sim::OnTxEnd( void )
+{
+  switch ( TxFrame.Kind )
+  {
+    case SIM_FRAME_RANGING_REQUEST:
+      // The master listens for the response of the addressed slave
+      OperatingMode = MODE_RX;
+      RangingWait = true;
+      TimeoutAt = Channel->Now( ) + SIM_RANGING_TURNAROUND + GetTimeOnAir( GetRangingIdLength( ) ) + SIM_RANGING_MARGIN;
+      break;
+
+    case SIM_FRAME_RANGING_RESPONSE:
+      EndOperation( RxContinuous );
+      RaiseIrq( IRQ_RANGING_SLAVE_RESPONSE_DONE );
+      break;
+
+    default:
+      EndOperation( false );
+      RaiseIrq( IRQ_TX_DONE );
+      break;
+  }
+}
+
+void SX1280Sim::OnRangingResult( const SimFrame_t &frame )
+{
+  double distance = GetDistance( frame.Source ) + RangingBias + RangingDeviation * Channel->Gaussian( );
+
+  // Frequency error the slave wrote in OnFrameEnd( ) for the request, the
+  // opposite of the one this radio wrote for the response
+  distance += RangingFeiGradient * ( FrequencyOffset - frame.Source->FrequencyOffset ) / 1000.0;
+
+  // Inverse of distance [m] = complement2( raw ) * 150 / ( 2^12 * bandwidth [MHz] )
+  RangingRaw = ( uint32_t )( int32_t )lround( distance * GetBandwidth( ) / 36621.09375 ) & 0xFFFFFF;
+
+  // The filtered result averages every measure since the last clear, in 0.2 m steps
+  RangingSum += distance;
+  RangingCount++;
+  RangingFiltered = ( uint32_t )lround( ( RangingSum / RangingCount ) * 5.0 ) & 0xFFFFFF;
+}
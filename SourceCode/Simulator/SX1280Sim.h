@@ -0,0 +1,200 @@
+#ifndef __SX1280_SIM_H__
+#define __SX1280_SIM_H__
+
+#include <stdint.h>
+#include "Header.h"
+#include "SimChannel.h"
+
+/*!
+   \brief Behavioural model of a SX1280, driven through its SPI frames
+
+   The model decodes the opcodes of RadioCommands_t and keeps the data
+   buffer, the register file, the IRQ status and masks, the operating mode
+   and the BUSY line. Frames are sent and received through a SimChannel,
+   ranging slaves answer the requests on their own as the real chip does.
+
+   \remark Timings are approximations taken from the datasheet transition
+           tables, close enough to exercise the BUSY and IRQ handling of a
+           driver, not to characterise it
+*/
+class SX1280Sim
+{
+public:
+  /*!
+     \brief Creates a radio in STDBY_RC mode and attaches it to the channel
+  */
+  SX1280Sim( SimChannel *channel );
+
+  /*!
+     \brief Pulses NRESET: every setting is lost and BUSY stays high while
+     the chip boots
+  */
+  void Reset( void );
+
+  /*!
+     \brief Clocks a whole SPI frame, selected by a single NSS low period
+
+     \param [in,out] frame      Bytes sent by the host, overwritten with the
+                                bytes sent back by the radio
+     \param [in]  size          Size of the frame
+  */
+  void Transfer( uint8_t *frame, uint16_t size );
+
+  /*!
+     \brief Returns the level of the BUSY line
+  */
+  bool GetBusy( void ) const;
+
+  /*!
+     \brief Returns the time at which BUSY falls after the last command [us]
+  */
+  uint64_t GetBusyUntil( void ) const;
+
+  /*!
+     \brief Returns the DIO lines as [ DIO3 | DIO2 | DIO1 | BUSY ]
+  */
+  uint8_t GetDio( void ) const;
+
+  /*!
+     \brief Sets the function run on every DIO1 rising edge
+  */
+  void SetDio1Handler( void ( *handler )( void ) );
+
+  /*!
+     \brief Places the radio, used for ranging results and received power [m]
+  */
+  void SetPosition( double x, double y, double z );
+
+  /*!
+     \brief Returns the distance to another radio [m]
+  */
+  double GetDistance( const SX1280Sim *other ) const;
+
+  /*!
+     \brief Sets the offset of the crystal of this radio [Hz], the receivers
+     see the difference in their frequency error estimation
+  */
+  void SetFrequencyOffset( int32_t offset );
+
+  /*!
+     \brief Sets the bias [m] and the standard deviation [m] added to the
+     distances measured by this radio as ranging master
+  */
+  void SetRangingError( double bias, double deviation );
+
+  /*!
+     \brief Sets the distance error [m] per kHz of the frequency error the
+     slave measures on the request, added to the distances measured by this
+     radio as ranging master, as RangingFeiGradients describe it
+  */
+  void SetRangingFeiGradient( double gradient );
+
+  /*!
+     \brief Waits for BUSY then sends a command, for test harnesses driving
+     a radio without the driver
+  */
+  void Command( RadioCommands_t opcode, const uint8_t *params, uint16_t size );
+
+  RadioOperatingModes_t GetOperatingMode( void ) const;
+  uint16_t GetIrqStatus( void ) const;
+  void ClearIrqStatus( uint16_t irq );
+  const uint8_t *GetBuffer( void ) const;
+  uint8_t GetRxPayloadLength( void ) const;
+  uint8_t GetRxStartBufferPointer( void ) const;
+  uint8_t GetRegister( uint16_t address ) const;
+  void SetRegister( uint16_t address, uint8_t value );
+
+  /*!
+     \brief Number of frames received while BUSY was high, or with an
+     unknown opcode, and thus ignored
+  */
+  uint32_t GetIgnoredCommands( void ) const;
+
+  /*!
+     \brief Time of the next internal event, used by the channel
+  */
+  uint64_t GetNextEvent( void ) const;
+
+  /*!
+     \brief Runs the internal events due at the given time, used by the channel
+  */
+  void Update( uint64_t now );
+
+  /*!
+     \brief A frame starts reaching the antenna, used by the channel
+  */
+  void OnFrameStart( uint32_t id, const SimFrame_t &frame );
+
+  /*!
+     \brief A frame has been fully received, used by the channel
+  */
+  void OnFrameEnd( uint32_t id, const SimFrame_t &frame, bool corrupted );
+
+private:
+  SimChannel *Channel;
+  void ( *Dio1Handler )( void );
+
+  RadioOperatingModes_t OperatingMode;
+  RadioPacketTypes_t PacketType;
+  uint32_t Frequency;
+  uint8_t ModulationParams[3];
+  uint8_t PacketParams[7];
+  int8_t TxPower;
+  uint8_t CadSymbols;
+  uint8_t TxBaseAddress;
+  uint8_t RxBaseAddress;
+  uint8_t RangingRole;
+  bool AutoFs;
+
+  uint8_t Buffer[256];
+  uint8_t Registers[0x10000];
+  uint8_t RxPayloadLength;
+  uint8_t RxStartBufferPointer;
+  uint8_t PacketStatus[5];
+
+  uint16_t IrqStatus;
+  uint16_t IrqMask;
+  uint16_t DioMask[3];
+  bool Dio1Level;
+
+  uint64_t BusyUntil;
+  uint64_t TxEndAt;
+  uint64_t TimeoutAt;
+  uint64_t CadEndAt;
+  uint64_t ResponseAt;
+  bool RxContinuous;
+  bool RangingWait;
+  uint32_t LockedFrame;
+  SimFrame_t TxFrame;
+  uint32_t IgnoredCommands;
+
+  double Position[3];
+  int32_t FrequencyOffset;
+  double RangingBias;
+  double RangingDeviation;
+  double RangingFeiGradient;
+  double RangingSum;
+  uint32_t RangingCount;
+  uint32_t RangingRaw;
+  uint32_t RangingFiltered;
+
+  uint8_t GetStatusByte( void ) const;
+  uint8_t ReadRegister( uint16_t address ) const;
+  void WriteRegister( uint16_t address, uint8_t value );
+  void RaiseIrq( uint16_t irq );
+  void UpdateDio1( void );
+  void EndOperation( bool stayInRx );
+  void Abort( void );
+  uint32_t GetBandwidth( void ) const;
+  uint32_t GetSymbolTime( void ) const;
+  uint32_t GetTimeOnAir( uint8_t size ) const;
+  uint32_t GetTickTime( const uint8_t *timeout ) const;
+  uint8_t GetRangingIdLength( void ) const;
+  uint32_t GetRangingAddress( uint16_t address ) const;
+  bool IsListening( const SimFrame_t &frame ) const;
+  void StartTx( uint64_t start, SimFrameKinds_t kind, uint32_t timeout );
+  void OnTxEnd( void );
+  void OnRangingResult( const SimFrame_t &frame );
+};
+
+#endif /* __SX1280_SIM_H__ */
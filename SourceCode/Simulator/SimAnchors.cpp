@@ -0,0 +1,178 @@
+/*
+   Tag ranging several anchors in turn with the ranging scheduler of the
+   driver, against simulated ranging slaves placed around it. Reports the
+   round rate and the latency of the slots.
+
+   The anchors are given crystal offsets of alternate signs, and the tag
+   measures distances off by the frequency error times the gradient of
+   RangingCalibration.h, which the driver removes unless told not to.
+
+   Usage: SimAnchors [ anchors [ rounds [ slot [ loss [ offset [ compensate ] ] ] ] ] ]
+          slot in us, 0 starting each exchange as soon as the previous one ends
+          offset in kHz, compensate 0 leaving the frequency error gradient out
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Radio.h"
+#include "SimTransport.h"
+
+#define RF_FREQUENCY                                2402000000// Hz
+#define TX_OUTPUT_POWER                             13 // dBm
+#define RANGING_CALIBRATION                         13376 // SF10, BW 1600
+#define RANGING_FEI_GRADIENT                        -0.870 // m/kHz, SF10, BW 1600
+#define MAX_ANCHORS                                 8
+
+static const uint32_t Addresses[MAX_ANCHORS] = {
+  0x10000000, 0x32100000, 0x20012301, 0x20000abc,
+  0x32101230, 0x10000001, 0x32100001, 0x20012302
+};
+
+static RadioCallbacks_t Callbacks = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
+static void AnchorInit( SX1280Sim *radio, uint32_t address )
+{
+  uint32_t freq = ( uint32_t )( ( double )RF_FREQUENCY / ( double )FREQ_STEP );
+  const uint8_t packetType[] = { PACKET_TYPE_RANGING };
+  const uint8_t modulationParams[] = { LORA_SF10, LORA_BW_1600, LORA_CR_LI_4_5 };
+  const uint8_t packetParams[] = { 12, LORA_PACKET_VARIABLE_LENGTH, 7, LORA_CRC_ON, LORA_IQ_NORMAL, 0, 0 };
+  const uint8_t rfFrequency[] = { ( uint8_t )( freq >> 16 ), ( uint8_t )( freq >> 8 ), ( uint8_t )freq };
+  const uint8_t deviceAddress[] = { REG_LR_DEVICERANGINGADDR >> 8, REG_LR_DEVICERANGINGADDR & 0xFF,
+                                    ( uint8_t )( address >> 24 ), ( uint8_t )( address >> 16 ), ( uint8_t )( address >> 8 ), ( uint8_t )address
+                                  };
+  const uint8_t idLength[] = { REG_LR_RANGINGIDCHECKLENGTH >> 8, REG_LR_RANGINGIDCHECKLENGTH & 0xFF, RANGING_IDCHECK_LENGTH_32_BITS << 6 };
+  const uint8_t role[] = { RADIO_RANGING_ROLE_SLAVE };
+  const uint8_t irqParams[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+  const uint8_t rxContinuous[] = { RADIO_TICK_SIZE_1000_US, 0xFF, 0xFF };
+
+  radio->Command( RADIO_SET_PACKETTYPE, packetType, sizeof( packetType ) );
+  radio->Command( RADIO_SET_MODULATIONPARAMS, modulationParams, sizeof( modulationParams ) );
+  radio->Command( RADIO_SET_PACKETPARAMS, packetParams, sizeof( packetParams ) );
+  radio->Command( RADIO_SET_RFFREQUENCY, rfFrequency, sizeof( rfFrequency ) );
+  radio->Command( RADIO_WRITE_REGISTER, idLength, sizeof( idLength ) );
+  radio->Command( RADIO_WRITE_REGISTER, deviceAddress, sizeof( deviceAddress ) );
+  radio->Command( RADIO_SET_RANGING_ROLE, role, sizeof( role ) );
+  radio->Command( RADIO_SET_DIOIRQPARAMS, irqParams, sizeof( irqParams ) );
+  radio->Command( RADIO_SET_RX, rxContinuous, sizeof( rxContinuous ) );
+}
+
+static void TagInit( bool compensate )
+{
+  ModulationParams_t modulationParams;
+  PacketParams_t packetParams;
+
+  modulationParams.PacketType = PACKET_TYPE_RANGING;
+  modulationParams.Params.LoRa.SpreadingFactor = LORA_SF10;
+  modulationParams.Params.LoRa.Bandwidth = LORA_BW_1600;
+  modulationParams.Params.LoRa.CodingRate = LORA_CR_LI_4_5;
+
+  packetParams.PacketType = PACKET_TYPE_RANGING;
+  packetParams.Params.LoRa.PreambleLength = 12;
+  packetParams.Params.LoRa.HeaderType = LORA_PACKET_VARIABLE_LENGTH;
+  packetParams.Params.LoRa.PayloadLength = 7;
+  packetParams.Params.LoRa.Crc = LORA_CRC_ON;
+  packetParams.Params.LoRa.InvertIQ = LORA_IQ_NORMAL;
+
+  Radio.SetStandby( STDBY_RC );
+  Radio.SetPacketType( modulationParams.PacketType );
+  Radio.SetModulationParams( &modulationParams );
+  Radio.SetPacketParams( &packetParams );
+  Radio.SetRfFrequency( RF_FREQUENCY );
+  Radio.SetTxParams( TX_OUTPUT_POWER, RADIO_RAMP_20_US );
+  Radio.SetBufferBaseAddresses( 0x00, 0x00 );
+  if ( compensate == true )
+  {
+    Radio.SetRangingProfile( LORA_BW_1600, LORA_SF10 );
+  }
+  else
+  {
+    Radio.SetRangingCalibration( RANGING_CALIBRATION );
+  }
+  Radio.SetRangingIdLength( RANGING_IDCHECK_LENGTH_32_BITS );
+  Radio.SetDioIrqParams( IRQ_RANGING_MASTER_RESULT_VALID | IRQ_RANGING_MASTER_TIMEOUT,
+                         IRQ_RANGING_MASTER_RESULT_VALID | IRQ_RANGING_MASTER_TIMEOUT, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+}
+
+int main( int argc, char **argv )
+{
+  uint8_t count = ( argc > 1 ) ? atoi( argv[1] ) : 4;
+  uint32_t rounds = ( argc > 2 ) ? atoi( argv[2] ) : 20;
+  uint32_t slot = ( argc > 3 ) ? atoi( argv[3] ) : 0;
+  double loss = ( argc > 4 ) ? atof( argv[4] ) : 0.05;
+  int32_t offset = ( argc > 5 ) ? atoi( argv[5] ) * 1000 : 20000;
+  bool compensate = ( argc > 6 ) ? ( atoi( argv[6] ) != 0 ) : true;
+  SimChannel channel( 1 );
+  SX1280Sim tag( &channel );
+  SX1280Sim *anchors[MAX_ANCHORS];
+  double sum[MAX_ANCHORS] = { 0.0 };
+  uint32_t valid[MAX_ANCHORS] = { 0 };
+  uint32_t received = 0;
+  uint64_t start;
+
+  if ( count > MAX_ANCHORS )
+  {
+    count = MAX_ANCHORS;
+  }
+  channel.SetLoss( loss );
+  tag.SetRangingError( 0.0, 0.5 );
+  tag.SetRangingFeiGradient( RANGING_FEI_GRADIENT );
+  for ( uint8_t i = 0; i < count; i++ )
+  {
+    anchors[i] = new SX1280Sim( &channel );
+    anchors[i]->SetPosition( 10.0 + 15.0 * i, 5.0 * i, 0.0 );
+    anchors[i]->SetFrequencyOffset( ( i & 1 ) ? -offset : offset );
+    AnchorInit( anchors[i], Addresses[i] );
+  }
+
+  SimTransport_Attach( &channel, &tag );
+  Radio.SetTransport( &SimTransport );
+  Radio.Init( &Callbacks );
+  Radio.SetRegulatorMode( USE_DCDC );
+  TagInit( compensate );
+
+  Radio.SetRangingAnchors( Addresses, count );
+  Radio.ResetRangingSchedulerStats( );
+  start = channel.Now( );
+  Radio.StartRangingScheduler( slot, ( TickTime_t ) {
+    RADIO_TICK_SIZE_1000_US, 0xFFFF
+  } );
+
+  // Main loop spinning every 10 us
+  while ( received < rounds )
+  {
+    RadioRangingRound_t round;
+
+    Radio.Dispatch( );
+    if ( Radio.GetRangingRound( &round ) == true )
+    {
+      for ( uint8_t i = 0; i < round.Count; i++ )
+      {
+        if ( round.Ranges[i].Valid == true )
+        {
+          sum[i] += round.Ranges[i].Distance / 256.0;
+          valid[i]++;
+        }
+      }
+      received++;
+    }
+    channel.Advance( 10 );
+  }
+  Radio.StopRangingScheduler( );
+
+  RadioRangingSchedulerStats_t stats = Radio.GetRangingSchedulerStats( );
+  double elapsed = ( channel.Now( ) - start ) / 1e6;
+
+  for ( uint8_t i = 0; i < count; i++ )
+  {
+    double x = 10.0 + 15.0 * i;
+    double y = 5.0 * i;
+
+    printf( "Anchor 0x%08X: distance %.2f m, mean %.2f m over %u exchanges\n", Addresses[i], sqrt( x * x + y * y ),
+            ( valid[i] > 0 ) ? sum[i] / valid[i] : 0.0, valid[i] );
+  }
+  printf( "%u rounds in %.3f s: %.1f rounds/s, %.1f exchanges/s, %u failed, %u overruns, %u dropped\n", stats.Rounds, elapsed,
+          stats.Rounds / elapsed, stats.Slots / elapsed, stats.Failed, stats.Overruns, stats.Dropped );
+  printf( "Slot latency mean %.0f us, max %u us, ignored commands %u\n", ( double )stats.TotalLatency / ( stats.Slots ? stats.Slots : 1 ),
+          stats.MaxLatency, tag.GetIgnoredCommands( ) );
+  return ( tag.GetIgnoredCommands( ) == 0 ) ? 0 : 1;
+}
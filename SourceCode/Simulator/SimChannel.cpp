@@ -0,0 +1,155 @@
+#include "SimChannel.h"
+#include "SX1280Sim.h"
+#include <math.h>
+
+SimChannel::SimChannel( uint32_t seed ) :
+  Time( 0 ), Seed( ( seed != 0 ) ? seed : 1 ), NextId( 1 ), Loss( 0.0 ), Corruption( 0.0 ), Delay( 0 )
+{
+}
+
+void SimChannel::Attach( SX1280Sim *radio )
+{
+  Radios.push_back( radio );
+}
+
+void SimChannel::SetLoss( double probability )
+{
+  Loss = probability;
+}
+
+void SimChannel::SetCorruption( double probability )
+{
+  Corruption = probability;
+}
+
+void SimChannel::SetDelay( uint32_t delay )
+{
+  Delay = delay;
+}
+
+uint64_t SimChannel::Now( void ) const
+{
+  return Time;
+}
+
+uint64_t SimChannel::GetNextEvent( void ) const
+{
+  uint64_t next = SIM_NEVER;
+
+  for ( size_t i = 0; i < Radios.size( ); i++ )
+  {
+    uint64_t event = Radios[i]->GetNextEvent( );
+    next = ( event < next ) ? event : next;
+  }
+  for ( size_t i = 0; i < Deliveries.size( ); i++ )
+  {
+    uint64_t event = Deliveries[i].Started ? Deliveries[i].End : Deliveries[i].Start;
+    next = ( event < next ) ? event : next;
+  }
+  return next;
+}
+
+void SimChannel::Advance( uint32_t time )
+{
+  RunUntil( Time + time );
+}
+
+void SimChannel::RunUntil( uint64_t time )
+{
+  uint64_t next;
+
+  while ( ( next = GetNextEvent( ) ) <= time )
+  {
+    Time = ( next > Time ) ? next : Time;
+
+    // Frame edges first, so that a timer expiring at the same time as a
+    // preamble is detected does not win over it
+    for ( size_t i = 0; i < Deliveries.size( ); i++ )
+    {
+      if ( ( Deliveries[i].Started == false ) && ( Deliveries[i].Start <= Time ) )
+      {
+        Deliveries[i].Started = true;
+        Deliveries[i].Destination->OnFrameStart( Deliveries[i].Id, Deliveries[i].Frame );
+      }
+    }
+    for ( size_t i = 0; i < Deliveries.size( ); )
+    {
+      if ( ( Deliveries[i].Started == true ) && ( Deliveries[i].End <= Time ) )
+      {
+        SimDelivery_t delivery = Deliveries[i];
+
+        Deliveries.erase( Deliveries.begin( ) + i );
+        delivery.Destination->OnFrameEnd( delivery.Id, delivery.Frame, delivery.Corrupted );
+      }
+      else
+      {
+        i++;
+      }
+    }
+    for ( size_t i = 0; i < Radios.size( ); i++ )
+    {
+      Radios[i]->Update( Time );
+    }
+  }
+  Time = ( time > Time ) ? time : Time;
+}
+
+void SimChannel::Transmit( const SimFrame_t &frame, uint64_t start, uint64_t end )
+{
+  for ( size_t i = 0; i < Radios.size( ); i++ )
+  {
+    SimDelivery_t delivery;
+
+    if ( Radios[i] == frame.Source )
+    {
+      continue;
+    }
+    // A lost frame is not even seen by CAD on that receiver
+    if ( Random( ) < Loss )
+    {
+      continue;
+    }
+    delivery.Id = NextId++;
+    delivery.Destination = Radios[i];
+    delivery.Frame = frame;
+    delivery.Start = start + Delay;
+    delivery.End = end + Delay;
+    delivery.Started = false;
+    delivery.Corrupted = ( Random( ) < Corruption );
+    Deliveries.push_back( delivery );
+  }
+}
+
+bool SimChannel::IsOccupied( const SX1280Sim *listener, uint32_t frequency, uint64_t time ) const
+{
+  for ( size_t i = 0; i < Deliveries.size( ); i++ )
+  {
+    if ( ( Deliveries[i].Destination == listener ) && ( Deliveries[i].Frame.Frequency == frequency ) &&
+         ( Deliveries[i].Start <= time ) && ( Deliveries[i].End >= time ) )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+double SimChannel::Random( void )
+{
+  // xorshift32, good enough for loss and noise draws and reproducible
+  Seed ^= Seed << 13;
+  Seed ^= Seed >> 17;
+  Seed ^= Seed << 5;
+  return ( double )Seed / 4294967296.0;
+}
+
+double SimChannel::Gaussian( void )
+{
+  double u1 = Random( );
+  double u2 = Random( );
+
+  if ( u1 < 1e-12 )
+  {
+    u1 = 1e-12;
+  }
+  return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
@@ -0,0 +1,148 @@
+#ifndef __SIM_CHANNEL_H__
+#define __SIM_CHANNEL_H__
+
+#include <stdint.h>
+#include <vector>
+#include "Header.h"
+
+class SX1280Sim;
+
+/*!
+   \brief Time value meaning that no event is scheduled
+*/
+#define SIM_NEVER                                   UINT64_MAX
+
+/*!
+   \brief Kind of frame sent over the simulated channel
+*/
+typedef enum
+{
+  SIM_FRAME_DATA                          = 0x00,
+  SIM_FRAME_RANGING_REQUEST,
+  SIM_FRAME_RANGING_RESPONSE,
+} SimFrameKinds_t;
+
+/*!
+   \brief A frame as put on air by a simulated radio
+*/
+typedef struct
+{
+  SX1280Sim *Source;                                      //!< Radio sending the frame
+  SimFrameKinds_t Kind;                                   //!< Data frame or ranging exchange
+  RadioPacketTypes_t PacketType;                          //!< Modem used to send the frame
+  uint32_t Frequency;                                     //!< RF frequency in PLL steps, as given to SetRfFrequency
+  uint8_t ModulationParams[3];                            //!< Modulation parameters as given to SetModulationParams
+  uint32_t Address;                                       //!< Ranging address, for the ranging frames
+  uint8_t Payload[256];                                   //!< Payload content
+  uint8_t Size;                                           //!< Payload size in bytes
+  int8_t Power;                                           //!< Output power [dBm]
+} SimFrame_t;
+
+/*!
+   \brief Virtual radio channel shared by several simulated SX1280
+
+   The channel owns the simulated time: nothing happens between two calls
+   to Advance( ) or RunUntil( ), which run every radio timer and frame
+   delivery due in the meantime in time order. A simulated run is thus only
+   bounded by the host CPU, not by the air time of the frames.
+*/
+class SimChannel
+{
+public:
+  /*!
+     \brief Creates an empty channel
+
+     \param [in]  seed          Seed of the loss, corruption and noise generator
+  */
+  SimChannel( uint32_t seed = 1 );
+
+  /*!
+     \brief Adds a radio to the channel, done by the SX1280Sim constructor
+  */
+  void Attach( SX1280Sim *radio );
+
+  /*!
+     \brief Sets the probability a frame is not heard at all by a receiver
+  */
+  void SetLoss( double probability );
+
+  /*!
+     \brief Sets the probability a frame is received with a CRC error
+  */
+  void SetCorruption( double probability );
+
+  /*!
+     \brief Sets the propagation and processing delay added to every frame [us]
+  */
+  void SetDelay( uint32_t delay );
+
+  /*!
+     \brief Returns the simulated time [us]
+  */
+  uint64_t Now( void ) const;
+
+  /*!
+     \brief Returns the time of the next radio timer or frame event
+  */
+  uint64_t GetNextEvent( void ) const;
+
+  /*!
+     \brief Runs the simulation for the given duration [us]
+  */
+  void Advance( uint32_t time );
+
+  /*!
+     \brief Runs the simulation up to the given absolute time [us]
+  */
+  void RunUntil( uint64_t time );
+
+  /*!
+     \brief Puts a frame on air, called by the sending radio
+
+     \param [in]  frame         Frame sent
+     \param [in]  start         Time the first preamble symbol leaves the antenna
+     \param [in]  end           Time the last symbol leaves the antenna
+  */
+  void Transmit( const SimFrame_t &frame, uint64_t start, uint64_t end );
+
+  /*!
+     \brief Tells whether a frame is on air for a listener, used by CAD
+  */
+  bool IsOccupied( const SX1280Sim *listener, uint32_t frequency, uint64_t time ) const;
+
+  /*!
+     \brief Returns a uniform random number in [ 0, 1 [
+  */
+  double Random( void );
+
+  /*!
+     \brief Returns a normal random number of mean 0 and deviation 1
+  */
+  double Gaussian( void );
+
+private:
+  /*!
+     \brief A frame on its way to one receiver
+  */
+  typedef struct
+  {
+    uint32_t Id;
+    SX1280Sim *Destination;
+    SimFrame_t Frame;
+    uint64_t Start;
+    uint64_t End;
+    bool Started;
+    bool Corrupted;
+  } SimDelivery_t;
+
+  std::vector<SX1280Sim *> Radios;
+  std::vector<SimDelivery_t> Deliveries;
+  uint64_t Time;
+  uint32_t Seed;
+  uint32_t NextId;
+  double Loss;
+  double Corruption;
+  uint32_t Delay;
+};
+
+#endif /* __SIM_CHANNEL_H__ */
@@ -0,0 +1,132 @@
+/*
+   Conversion of RF frequencies to PLL steps, by the multiply-shift of the
+   driver against the division by FREQ_STEP it replaced.
+
+   The multiply-shift, the same expression as FormatRfFrequency( ) and
+   SX1280::SetRfFrequency( ), is compared with the double division for
+   every 32-bit frequency. FormatRfFrequency( ) itself is checked on the
+   2.4 GHz band, and both conversions are timed over the band.
+
+   Usage: SimFrequency [ band only ]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+#include "Radio.h"
+
+// Internal of the driver, not part of Radio_t
+void FormatRfFrequency(uint32_t rfFrequency, uint8_t *buf);
+
+#define BAND_START                                  2400000000UL // Hz
+#define BAND_END                                    2500000000UL // Hz
+
+#if RADIO_INTEGER_FREQUENCY == 0
+#error "SimFrequency checks the integer conversion, build it with RADIO_INTEGER_FREQUENCY 1"
+#endif
+
+/*!
+   \brief Cycle counter where there is one, nanoseconds otherwise
+*/
+static inline uint64_t Ticks( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+  return __rdtsc( );
+#else
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ( uint64_t )ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static inline double Seconds( void )
+{
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static inline uint32_t StepsInteger( uint32_t rfFrequency )
+{
+  uint64_t high = ( uint64_t )rfFrequency * FREQ_STEP_MULTIPLIER_HIGH;
+  uint64_t low = ( uint64_t )rfFrequency * FREQ_STEP_MULTIPLIER_LOW;
+
+  return ( uint32_t )( ( high + ( low >> 32 ) ) >> ( FREQ_STEP_SHIFT - 32 ) );
+}
+
+static inline uint32_t StepsDouble( uint32_t rfFrequency )
+{
+  return ( uint32_t )( ( double )rfFrequency / ( double )FREQ_STEP );
+}
+
+int main( int argc, char **argv )
+{
+  bool bandOnly = ( argc > 1 ) && ( atoi( argv[1] ) != 0 );
+  uint64_t mismatches = 0;
+  uint32_t driverMismatches = 0;
+  volatile uint32_t sink = 0;
+  double start;
+
+  // Every 32-bit frequency
+  if ( bandOnly == false )
+  {
+    start = Seconds( );
+    for ( uint64_t f = 0; f <= 0xFFFFFFFFULL; f++ )
+    {
+      if ( StepsInteger( ( uint32_t )f ) != StepsDouble( ( uint32_t )f ) )
+      {
+        if ( mismatches++ < 10 )
+        {
+          printf( "Mismatch at %llu Hz: %u steps instead of %u\n", ( unsigned long long )f,
+                  StepsInteger( ( uint32_t )f ), StepsDouble( ( uint32_t )f ) );
+        }
+      }
+    }
+    printf( "All 2^32 frequencies: %llu mismatches (%.1f s)\n", ( unsigned long long )mismatches, Seconds( ) - start );
+  }
+
+  // The frame the driver sends on the band
+  for ( uint32_t f = BAND_START; f <= BAND_END; f++ )
+  {
+    uint8_t buf[3];
+    uint32_t steps = StepsDouble( f );
+
+    FormatRfFrequency( f, buf );
+    if ( ( buf[0] != ( uint8_t )( steps >> 16 ) ) || ( buf[1] != ( uint8_t )( steps >> 8 ) ) || ( buf[2] != ( uint8_t )steps ) )
+    {
+      if ( driverMismatches++ < 10 )
+      {
+        printf( "FormatRfFrequency mismatch at %u Hz\n", f );
+      }
+    }
+  }
+  printf( "FormatRfFrequency from %lu to %lu Hz: %u mismatches\n", BAND_START, BAND_END, driverMismatches );
+
+  // Timings over the band, the frequency made opaque to the compiler so the
+  // loop is not vectorised or folded
+  for ( uint8_t method = 0; method < 2; method++ )
+  {
+    volatile uint32_t step = 1;
+    uint64_t ticks;
+    double seconds;
+    uint32_t count = 0;
+
+    start = Seconds( );
+    ticks = Ticks( );
+    for ( uint32_t f = BAND_START; f < BAND_END; f += step )
+    {
+      sink += ( method == 0 ) ? StepsDouble( f ) : StepsInteger( f );
+      count++;
+    }
+    ticks = Ticks( ) - ticks;
+    seconds = Seconds( ) - start;
+    printf( "%-15s %.2f ticks, %.2f ns per conversion\n", ( method == 0 ) ? "Double division" : "Multiply-shift",
+            ( double )ticks / count, seconds * 1e9 / count );
+  }
+  return ( ( mismatches == 0 ) && ( driverMismatches == 0 ) ) ? 0 : 1;
+}
@@ -0,0 +1,435 @@
+/*
+   IRQ decoding of the driver by its dispatch table against the nested
+   switches it replaced, on the loopback transport. Every packet type,
+   operating mode and IRQ status is decoded by both: the events must be the
+   same, in any order, and the time of each decode is measured.
+
+   Both decoders end in the QueueEvent( ) of the driver, so the times
+   include queueing the events, and the RX done events read the buffer
+   status over the loopback transport. The ticks are those of the host,
+   whose branch predictor learns the if-chain over a sweep: they rank the
+   decoders, a microcontroller pays more for each branch.
+
+   Then, with the hop engine triggered by the end of ranging exchanges,
+   every ranging status must hop once when one of its bits ends an
+   exchange, in particular when the slave latches two such bits, and never
+   otherwise.
+
+   Usage: SimIrqDispatch [ passes ]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+#include "Radio.h"
+
+// Internals of the driver, not part of Radio_t
+void DecodeIrqs(uint16_t irqRegs, uint32_t timestamp);
+void QueueEvent(RadioEventTypes_t type, uint16_t irqRegs, uint32_t timestamp, uint8_t param);
+
+#define MAX_EVENTS                                  8
+#define HOP_CHANNELS                                4
+
+/*!
+   \brief An event reduced to what the decoders choose
+*/
+typedef struct
+{
+  uint8_t Count;
+  uint16_t Codes[MAX_EVENTS];
+} Events_t;
+
+static const RadioPacketTypes_t PacketTypes[] = { PACKET_TYPE_GFSK, PACKET_TYPE_LORA, PACKET_TYPE_RANGING, PACKET_TYPE_FLRC, PACKET_TYPE_BLE };
+static const char *PacketTypeNames[] = { "GFSK", "LoRa", "Ranging", "FLRC", "BLE" };
+static const char *ModeNames[] = { "RX", "TX", "CAD" };
+
+/*!
+   \brief Cycle counter where there is one, nanoseconds otherwise
+*/
+static inline uint64_t Ticks( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+  return __rdtsc( );
+#else
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ( uint64_t )ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/*!
+   \brief Decoding of the driver before the dispatch table, the callbacks
+   turned into the events Poll( ) returns
+*/
+static void DecodeIfChain( RadioPacketTypes_t packetType, uint8_t mode, uint16_t irqRegs, uint32_t timestamp )
+{
+  switch ( packetType )
+  {
+    case PACKET_TYPE_GFSK:
+    case PACKET_TYPE_FLRC:
+    case PACKET_TYPE_BLE:
+      switch ( mode )
+      {
+        case MODE_RX:
+          if ( ( irqRegs & IRQ_RX_DONE ) == IRQ_RX_DONE )
+          {
+            if ( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
+            {
+              QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_CRC_ERROR_CODE );
+            }
+            else if ( ( irqRegs & IRQ_SYNCWORD_ERROR ) == IRQ_SYNCWORD_ERROR )
+            {
+              QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_SYNCWORD_ERROR_CODE );
+            }
+            else
+            {
+              QueueEvent( RADIO_EVENT_RX_DONE, irqRegs, timestamp, 0 );
+            }
+          }
+          if ( ( irqRegs & IRQ_SYNCWORD_VALID ) == IRQ_SYNCWORD_VALID )
+          {
+            QueueEvent( RADIO_EVENT_RX_SYNCWORD_DONE, irqRegs, timestamp, 0 );
+          }
+          if ( ( irqRegs & IRQ_SYNCWORD_ERROR ) == IRQ_SYNCWORD_ERROR )
+          {
+            QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_SYNCWORD_ERROR_CODE );
+          }
+          if ( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_RX_TIMEOUT, irqRegs, timestamp, 0 );
+          }
+          break;
+        case MODE_TX:
+          if ( ( irqRegs & IRQ_TX_DONE ) == IRQ_TX_DONE )
+          {
+            QueueEvent( RADIO_EVENT_TX_DONE, irqRegs, timestamp, 0 );
+          }
+          if ( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_TX_TIMEOUT, irqRegs, timestamp, 0 );
+          }
+          break;
+        default:
+          break;
+      }
+      break;
+    case PACKET_TYPE_LORA:
+      switch ( mode )
+      {
+        case MODE_RX:
+          if ( ( irqRegs & IRQ_RX_DONE ) == IRQ_RX_DONE )
+          {
+            if ( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
+            {
+              QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_CRC_ERROR_CODE );
+            }
+            else
+            {
+              QueueEvent( RADIO_EVENT_RX_DONE, irqRegs, timestamp, 0 );
+            }
+          }
+          if ( ( irqRegs & IRQ_HEADER_VALID ) == IRQ_HEADER_VALID )
+          {
+            QueueEvent( RADIO_EVENT_RX_HEADER_DONE, irqRegs, timestamp, 0 );
+          }
+          if ( ( irqRegs & IRQ_HEADER_ERROR ) == IRQ_HEADER_ERROR )
+          {
+            QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_HEADER_ERROR_CODE );
+          }
+          if ( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_RX_TIMEOUT, irqRegs, timestamp, 0 );
+          }
+          if ( ( irqRegs & IRQ_RANGING_SLAVE_REQUEST_DISCARDED ) == IRQ_RANGING_SLAVE_REQUEST_DISCARDED )
+          {
+            QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_RANGING_ON_LORA_ERROR_CODE );
+          }
+          break;
+        case MODE_TX:
+          if ( ( irqRegs & IRQ_TX_DONE ) == IRQ_TX_DONE )
+          {
+            QueueEvent( RADIO_EVENT_TX_DONE, irqRegs, timestamp, 0 );
+          }
+          if ( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_TX_TIMEOUT, irqRegs, timestamp, 0 );
+          }
+          break;
+        case MODE_CAD:
+          if ( ( irqRegs & IRQ_CAD_DONE ) == IRQ_CAD_DONE )
+          {
+            QueueEvent( RADIO_EVENT_CAD_DONE, irqRegs, timestamp, ( irqRegs & IRQ_CAD_DETECTED ) == IRQ_CAD_DETECTED );
+          }
+          else if ( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_RX_TIMEOUT, irqRegs, timestamp, 0 );
+          }
+          break;
+        default:
+          break;
+      }
+      break;
+    case PACKET_TYPE_RANGING:
+      switch ( mode )
+      {
+        case MODE_RX:
+          if ( ( irqRegs & IRQ_RANGING_SLAVE_REQUEST_DISCARDED ) == IRQ_RANGING_SLAVE_REQUEST_DISCARDED )
+          {
+            QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_SLAVE_ERROR_CODE );
+          }
+          if ( ( irqRegs & IRQ_RANGING_SLAVE_REQUEST_VALID ) == IRQ_RANGING_SLAVE_REQUEST_VALID )
+          {
+            QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_SLAVE_VALID_CODE );
+          }
+          if ( ( irqRegs & IRQ_RANGING_SLAVE_RESPONSE_DONE ) == IRQ_RANGING_SLAVE_RESPONSE_DONE )
+          {
+            QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_SLAVE_VALID_CODE );
+          }
+          if ( ( irqRegs & IRQ_RX_TX_TIMEOUT ) == IRQ_RX_TX_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_SLAVE_ERROR_CODE );
+          }
+          if ( ( irqRegs & IRQ_HEADER_VALID ) == IRQ_HEADER_VALID )
+          {
+            QueueEvent( RADIO_EVENT_RX_HEADER_DONE, irqRegs, timestamp, 0 );
+          }
+          if ( ( irqRegs & IRQ_HEADER_ERROR ) == IRQ_HEADER_ERROR )
+          {
+            QueueEvent( RADIO_EVENT_RX_ERROR, irqRegs, timestamp, IRQ_HEADER_ERROR_CODE );
+          }
+          break;
+        case MODE_TX:
+          if ( ( irqRegs & IRQ_RANGING_MASTER_TIMEOUT ) == IRQ_RANGING_MASTER_TIMEOUT )
+          {
+            QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_MASTER_ERROR_CODE );
+          }
+          if ( ( irqRegs & IRQ_RANGING_MASTER_RESULT_VALID ) == IRQ_RANGING_MASTER_RESULT_VALID )
+          {
+            QueueEvent( RADIO_EVENT_RANGING_DONE, irqRegs, timestamp, IRQ_RANGING_MASTER_VALID_CODE );
+          }
+          break;
+        default:
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+   \brief Empties the event queue into a sorted list of type and code
+*/
+static void Drain( Events_t *events )
+{
+  RadioEvent_t event;
+
+  events->Count = 0;
+  while ( Radio.Poll( &event ) == true )
+  {
+    uint8_t code = 0;
+
+    switch ( event.Type )
+    {
+      case RADIO_EVENT_RX_ERROR:
+        code = event.ErrorCode;
+        break;
+      case RADIO_EVENT_RANGING_DONE:
+        code = event.RangingCode;
+        break;
+      case RADIO_EVENT_CAD_DONE:
+        code = event.CadDetected;
+        break;
+      default:
+        break;
+    }
+    if ( events->Count < MAX_EVENTS )
+    {
+      uint16_t value = ( event.Type << 8 ) | code;
+      uint8_t i = events->Count++;
+
+      while ( ( i > 0 ) && ( events->Codes[i - 1] > value ) )
+      {
+        events->Codes[i] = events->Codes[i - 1];
+        i--;
+      }
+      events->Codes[i] = value;
+    }
+  }
+}
+
+static void SetMode( uint8_t mode )
+{
+  TickTime_t timeout = { RADIO_TICK_SIZE_1000_US, 0 };
+
+  switch ( mode )
+  {
+    case MODE_RX:
+      Radio.SetRx( timeout );
+      break;
+    case MODE_TX:
+      Radio.SetTx( timeout );
+      break;
+    default:
+      Radio.SetCad( );
+      break;
+  }
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t passes = ( argc > 1 ) ? atoi( argv[1] ) : 3;
+  const uint8_t modes[] = { MODE_RX, MODE_TX, MODE_CAD };
+  uint32_t mismatches = 0;
+  uint64_t overhead = ~0ULL;
+  uint64_t totalChain = 0;
+  uint64_t totalTable = 0;
+
+  Radio.SetTransport( &LoopbackTransport );
+  Radio.Init( NULL );
+
+  // Cost of reading the counter, taken off every decode
+  for ( uint32_t i = 0; i < 1000; i++ )
+  {
+    uint64_t start = Ticks( );
+    uint64_t ticks = Ticks( ) - start;
+
+    overhead = ( ticks < overhead ) ? ticks : overhead;
+  }
+
+  printf( "packet   mode   statuses  events   if-chain [ticks]  table [ticks]  single IRQ if-chain  table\n" );
+  for ( uint8_t t = 0; t < sizeof( PacketTypes ) / sizeof( PacketTypes[0] ); t++ )
+  {
+    for ( uint8_t m = 0; m < sizeof( modes ); m++ )
+    {
+      uint64_t chain = ~0ULL;
+      uint64_t table = ~0ULL;
+      uint64_t singleChain = ~0ULL;
+      uint64_t singleTable = ~0ULL;
+      uint32_t events = 0;
+      uint32_t singles = 0;
+
+      Radio.SetPacketType( PacketTypes[t] );
+      SetMode( modes[m] );
+      for ( uint32_t pass = 0; pass < passes; pass++ )
+      {
+        uint64_t sumChain = 0;
+        uint64_t sumTable = 0;
+        uint64_t sumSingleChain = 0;
+        uint64_t sumSingleTable = 0;
+
+        events = 0;
+        singles = 0;
+        for ( uint32_t irq = 0; irq <= 0xFFFF; irq++ )
+        {
+          Events_t expected;
+          Events_t actual;
+          uint64_t start;
+          uint64_t ticksChain;
+          uint64_t ticksTable;
+
+          start = Ticks( );
+          DecodeIfChain( PacketTypes[t], modes[m], irq, 0 );
+          ticksChain = Ticks( ) - start - overhead;
+          Drain( &expected );
+
+          start = Ticks( );
+          DecodeIrqs( irq, 0 );
+          ticksTable = Ticks( ) - start - overhead;
+          Drain( &actual );
+
+          sumChain += ticksChain;
+          sumTable += ticksTable;
+          events += expected.Count;
+          // A status with one bit and one event, as most DIO1 edges carry
+          if ( ( ( irq & ( irq - 1 ) ) == 0 ) && ( expected.Count == 1 ) )
+          {
+            sumSingleChain += ticksChain;
+            sumSingleTable += ticksTable;
+            singles++;
+          }
+          if ( ( pass == 0 ) && ( ( expected.Count != actual.Count ) ||
+                                  ( memcmp( expected.Codes, actual.Codes, expected.Count * sizeof( expected.Codes[0] ) ) != 0 ) ) )
+          {
+            if ( mismatches++ < 10 )
+            {
+              printf( "Mismatch %s %s IRQ 0x%04X: %u events instead of %u\n", PacketTypeNames[t], ModeNames[m], irq,
+                      actual.Count, expected.Count );
+            }
+          }
+        }
+        // Fastest pass, the others being slowed down by the host
+        chain = ( sumChain < chain ) ? sumChain : chain;
+        table = ( sumTable < table ) ? sumTable : table;
+        singleChain = ( sumSingleChain < singleChain ) ? sumSingleChain : singleChain;
+        singleTable = ( sumSingleTable < singleTable ) ? sumSingleTable : singleTable;
+      }
+      totalChain += chain;
+      totalTable += table;
+      printf( "%-8s %-5s %9u %7u %18.1f %14.1f", PacketTypeNames[t], ModeNames[m], 0x10000, events, chain / 65536.0, table / 65536.0 );
+      if ( singles > 0 )
+      {
+        printf( " %20.1f %6.1f\n", ( double )singleChain / singles, ( double )singleTable / singles );
+      }
+      else
+      {
+        printf( " %20s %6s\n", "-", "-" );
+      }
+    }
+  }
+  printf( "Mean over every status: if-chain %.1f ticks, table %.1f ticks, %u mismatches\n",
+          totalChain / ( 65536.0 * 15 ), totalTable / ( 65536.0 * 15 ), mismatches );
+
+  // One hop per ranging status, the slave side mapping two bits to each end
+  const uint32_t hopFrequencies[HOP_CHANNELS] = { 2402000000UL, 2426000000UL, 2450000000UL, 2474000000UL };
+  const uint16_t exchangeEnds[] = {
+    IRQ_RANGING_SLAVE_RESPONSE_DONE | IRQ_RANGING_SLAVE_REQUEST_DISCARDED | IRQ_RANGING_SLAVE_REQUEST_VALID | IRQ_RX_TX_TIMEOUT,
+    IRQ_RANGING_MASTER_RESULT_VALID | IRQ_RANGING_MASTER_TIMEOUT
+  };
+  const uint16_t slavePairs[] = {
+    IRQ_RANGING_SLAVE_RESPONSE_DONE | IRQ_RANGING_SLAVE_REQUEST_VALID,
+    IRQ_RANGING_SLAVE_REQUEST_DISCARDED | IRQ_RX_TX_TIMEOUT
+  };
+  uint32_t wrongHops = 0;
+
+  Radio.SetHopChannels( hopFrequencies, HOP_CHANNELS );
+  Radio.SetHopTrigger( RADIO_HOP_ON_RANGING_DONE );
+  Radio.SetPacketType( PACKET_TYPE_RANGING );
+  for ( uint8_t m = 0; m < 2; m++ )
+  {
+    SetMode( modes[m] );
+    for ( uint32_t irq = 0; irq <= 0xFFFF; irq++ )
+    {
+      Events_t events;
+      uint32_t hops = Radio.GetHopStats( ).Hops;
+
+      DecodeIrqs( irq, 0 );
+      Drain( &events );
+      hops = Radio.GetHopStats( ).Hops - hops;
+      if ( hops != ( ( ( irq & exchangeEnds[m] ) != 0 ) ? 1U : 0U ) )
+      {
+        if ( wrongHops++ < 10 )
+        {
+          printf( "Ranging %s IRQ 0x%04X: %u hops\n", ModeNames[m], irq, hops );
+        }
+      }
+    }
+  }
+  SetMode( MODE_RX );
+  for ( uint8_t i = 0; i < sizeof( slavePairs ) / sizeof( slavePairs[0] ); i++ )
+  {
+    Events_t events;
+    uint32_t hops = Radio.GetHopStats( ).Hops;
+
+    DecodeIrqs( slavePairs[i], 0 );
+    Drain( &events );
+    printf( "Ranging slave IRQ 0x%04X: %u hops\n", slavePairs[i], Radio.GetHopStats( ).Hops - hops );
+  }
+  Radio.SetHopTrigger( 0 );
+  printf( "Hops on ranging done: %u statuses hopping other than once per exchange end\n", wrongHops );
+  return ( ( mismatches == 0 ) && ( wrongHops == 0 ) ) ? 0 : 1;
+}
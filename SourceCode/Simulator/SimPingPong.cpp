@@ -0,0 +1,126 @@
+/*
+   PingPong master of the Arduino sketch, run by the driver on a simulated
+   radio, against a simulated receiver configured the same way.
+
+   Usage: SimPingPong [ packets [ loss ] ]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Radio.h"
+#include "SimTransport.h"
+
+#define RF_FREQUENCY                                2400000000// Hz
+#define TX_OUTPUT_POWER                             13 // dBm
+#define TX_TIMEOUT_VALUE                            10000 // ms
+#define TX_PERIOD                                   1000000 // us
+
+static volatile bool TxDone = false;
+
+static void txDoneIRQ( void )
+{
+  TxDone = true;
+}
+
+static RadioCallbacks_t Callbacks = { txDoneIRQ, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
+static void ReceiverInit( SX1280Sim *radio )
+{
+  uint32_t freq = ( uint32_t )( ( double )RF_FREQUENCY / ( double )FREQ_STEP );
+  const uint8_t packetType[] = { PACKET_TYPE_LORA };
+  const uint8_t modulationParams[] = { LORA_SF12, LORA_BW_1600, LORA_CR_LI_4_7 };
+  const uint8_t packetParams[] = { 12, LORA_PACKET_VARIABLE_LENGTH, 10, LORA_CRC_ON, LORA_IQ_NORMAL, 0, 0 };
+  const uint8_t rfFrequency[] = { ( uint8_t )( freq >> 16 ), ( uint8_t )( freq >> 8 ), ( uint8_t )freq };
+  const uint8_t baseAddresses[] = { 0x00, 0x00 };
+  const uint8_t irqParams[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+  const uint8_t rxContinuous[] = { RADIO_TICK_SIZE_1000_US, 0xFF, 0xFF };
+
+  radio->Command( RADIO_SET_PACKETTYPE, packetType, sizeof( packetType ) );
+  radio->Command( RADIO_SET_MODULATIONPARAMS, modulationParams, sizeof( modulationParams ) );
+  radio->Command( RADIO_SET_PACKETPARAMS, packetParams, sizeof( packetParams ) );
+  radio->Command( RADIO_SET_RFFREQUENCY, rfFrequency, sizeof( rfFrequency ) );
+  radio->Command( RADIO_SET_BUFFERBASEADDRESS, baseAddresses, sizeof( baseAddresses ) );
+  radio->Command( RADIO_SET_DIOIRQPARAMS, irqParams, sizeof( irqParams ) );
+  radio->Command( RADIO_SET_RX, rxContinuous, sizeof( rxContinuous ) );
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t packets = ( argc > 1 ) ? atoi( argv[1] ) : 100;
+  double loss = ( argc > 2 ) ? atof( argv[2] ) : 0.1;
+  SimChannel channel( 1 );
+  SX1280Sim master( &channel );
+  SX1280Sim slave( &channel );
+  ModulationParams_t modulationParams;
+  PacketParams_t packetParams;
+  uint32_t received = 0;
+  uint32_t errors = 0;
+  uint8_t counter = 0;
+
+  channel.SetLoss( loss );
+  slave.SetPosition( 100.0, 0.0, 0.0 );
+  ReceiverInit( &slave );
+
+  SimTransport_Attach( &channel, &master );
+  Radio.SetTransport( &SimTransport );
+  Radio.Init( &Callbacks );
+  Radio.SetRegulatorMode( USE_DCDC );
+
+  modulationParams.PacketType = PACKET_TYPE_LORA;
+  modulationParams.Params.LoRa.SpreadingFactor = LORA_SF12;
+  modulationParams.Params.LoRa.Bandwidth = LORA_BW_1600;
+  modulationParams.Params.LoRa.CodingRate = LORA_CR_LI_4_7;
+
+  packetParams.PacketType = PACKET_TYPE_LORA;
+  packetParams.Params.LoRa.PreambleLength = 12;
+  packetParams.Params.LoRa.HeaderType = LORA_PACKET_VARIABLE_LENGTH;
+  packetParams.Params.LoRa.PayloadLength = 10;
+  packetParams.Params.LoRa.Crc = LORA_CRC_ON;
+  packetParams.Params.LoRa.InvertIQ = LORA_IQ_NORMAL;
+
+  Radio.SetStandby( STDBY_RC );
+  Radio.SetPacketType( modulationParams.PacketType );
+  Radio.SetModulationParams( &modulationParams );
+  Radio.SetPacketParams( &packetParams );
+  Radio.SetRfFrequency( RF_FREQUENCY );
+  Radio.SetBufferBaseAddresses( 0x00, 0x00 );
+  Radio.SetTxParams( TX_OUTPUT_POWER, RADIO_RAMP_20_US );
+  Radio.SetDioIrqParams( IRQ_TX_DONE | IRQ_RX_TX_TIMEOUT, IRQ_TX_DONE | IRQ_RX_TX_TIMEOUT, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+
+  for ( uint32_t i = 0; i < packets; i++ )
+  {
+    uint64_t start = channel.Now( );
+
+    TxDone = false;
+    Radio.SendPayload( &counter, 1, ( TickTime_t ) {
+      RADIO_TICK_SIZE_1000_US, TX_TIMEOUT_VALUE
+    }, 0 );
+    while ( TxDone == false )
+    {
+      Radio.WaitForIrq( TX_TIMEOUT_VALUE );
+      Radio.Dispatch( );
+    }
+
+    // Let the frame reach the receiver before checking it
+    channel.RunUntil( start + TX_PERIOD );
+    if ( ( slave.GetIrqStatus( ) & IRQ_RX_DONE ) != 0 )
+    {
+      if ( ( ( slave.GetIrqStatus( ) & IRQ_CRC_ERROR ) != 0 ) || ( slave.GetBuffer( )[slave.GetRxStartBufferPointer( )] != counter ) )
+      {
+        errors++;
+      }
+      else
+      {
+        received++;
+      }
+      slave.ClearIrqStatus( IRQ_RADIO_ALL );
+    }
+    counter = ( counter + 1 ) % 101;
+  }
+
+  printf( "Sent %u, received %u, errors %u, PER %.1f %%\n", packets, received, errors,
+          100.0 * ( packets - received ) / ( ( packets > 0 ) ? packets : 1 ) );
+  printf( "Simulated time %.3f s, SPI transactions %u, ignored commands %u\n",
+          channel.Now( ) / 1e6, Radio.GetSpiTransactionCount( ), master.GetIgnoredCommands( ) );
+  return ( master.GetIgnoredCommands( ) == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/*
+   Ranging master of the Arduino sketch, run by the driver on a simulated
+   radio, against a simulated ranging slave placed at a known distance.
+
+   With a crystal offset, each single exchange is also compensated the way
+   the DevKit demo does it, from the frequency error the slave measures on
+   the request and relays, and compared with GetCompensatedRangingResult( ).
+
+   Usage: SimRanging [ distance [ count [ loss [ continuous [ offset ] ] ] ] ]
+          continuous 1 lets the driver re-arm each exchange by itself
+          offset of the slave crystal in kHz
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Radio.h"
+#include "SimTransport.h"
+#include "RangingCalibration.h"
+
+#define RF_FREQUENCY                                2402000000// Hz
+#define TX_OUTPUT_POWER                             13 // dBm
+#define RANGING_ADDRESS                             0x20012301
+#define RANGING_CALIBRATION                         13376 // SF10, BW 1600
+#define RANGING_BANDWIDTH_HZ                        1625000.0
+#define COMPENSATION_BOUND                          0.01 // m, driver against the demo
+
+static volatile bool RangingDone = false;
+static IrqRangingCode_t RangingCode = IRQ_RANGING_MASTER_ERROR_CODE;
+
+static void rangingDoneIRQ( IrqRangingCode_t val )
+{
+  RangingCode = val;
+  RangingDone = true;
+}
+
+static RadioCallbacks_t Callbacks = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, rangingDoneIRQ, NULL };
+
+static int32_t Complement2( uint32_t num, uint8_t bitCnt )
+{
+  int32_t retVal = ( int32_t )num;
+
+  if ( num >= ( 1UL << ( bitCnt - 1 ) ) )
+  {
+    retVal -= ( int32_t )( 1UL << bitCnt );
+  }
+  return retVal;
+}
+
+/*!
+   \brief Frequency error the slave measured on the request [Hz], as
+   SX1280::GetFrequencyError( ) of the DevKit demo reads it
+*/
+static double SlaveFrequencyError( const SX1280Sim *radio )
+{
+  uint32_t efe = ( ( uint32_t )radio->GetRegister( REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB ) << 16 ) |
+                 ( ( uint32_t )radio->GetRegister( REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB + 1 ) << 8 ) |
+                 radio->GetRegister( REG_LR_ESTIMATED_FREQUENCY_ERROR_MSB + 2 );
+
+  efe &= REG_LR_ESTIMATED_FREQUENCY_ERROR_MASK;
+  return 1.55 * ( double )Complement2( efe, 20 ) / ( 1600.0 / RANGING_BANDWIDTH_HZ * 1000.0 );
+}
+
+static void SlaveInit( SX1280Sim *radio )
+{
+  uint32_t freq = ( uint32_t )( ( double )RF_FREQUENCY / ( double )FREQ_STEP );
+  const uint8_t packetType[] = { PACKET_TYPE_RANGING };
+  const uint8_t modulationParams[] = { LORA_SF10, LORA_BW_1600, LORA_CR_LI_4_5 };
+  const uint8_t packetParams[] = { 12, LORA_PACKET_VARIABLE_LENGTH, 7, LORA_CRC_ON, LORA_IQ_NORMAL, 0, 0 };
+  const uint8_t rfFrequency[] = { ( uint8_t )( freq >> 16 ), ( uint8_t )( freq >> 8 ), ( uint8_t )freq };
+  const uint8_t address[] = { REG_LR_DEVICERANGINGADDR >> 8, REG_LR_DEVICERANGINGADDR & 0xFF,
+                              ( RANGING_ADDRESS >> 24 ) & 0xFF, ( RANGING_ADDRESS >> 16 ) & 0xFF, ( RANGING_ADDRESS >> 8 ) & 0xFF, RANGING_ADDRESS & 0xFF
+                            };
+  const uint8_t idLength[] = { REG_LR_RANGINGIDCHECKLENGTH >> 8, REG_LR_RANGINGIDCHECKLENGTH & 0xFF, RANGING_IDCHECK_LENGTH_32_BITS << 6 };
+  const uint8_t role[] = { RADIO_RANGING_ROLE_SLAVE };
+  const uint8_t irqParams[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+  const uint8_t rxContinuous[] = { RADIO_TICK_SIZE_1000_US, 0xFF, 0xFF };
+
+  radio->Command( RADIO_SET_PACKETTYPE, packetType, sizeof( packetType ) );
+  radio->Command( RADIO_SET_MODULATIONPARAMS, modulationParams, sizeof( modulationParams ) );
+  radio->Command( RADIO_SET_PACKETPARAMS, packetParams, sizeof( packetParams ) );
+  radio->Command( RADIO_SET_RFFREQUENCY, rfFrequency, sizeof( rfFrequency ) );
+  radio->Command( RADIO_WRITE_REGISTER, idLength, sizeof( idLength ) );
+  radio->Command( RADIO_WRITE_REGISTER, address, sizeof( address ) );
+  radio->Command( RADIO_SET_RANGING_ROLE, role, sizeof( role ) );
+  radio->Command( RADIO_SET_DIOIRQPARAMS, irqParams, sizeof( irqParams ) );
+  radio->Command( RADIO_SET_RX, rxContinuous, sizeof( rxContinuous ) );
+}
+
+int main( int argc, char **argv )
+{
+  double distance = ( argc > 1 ) ? atof( argv[1] ) : 25.0;
+  uint32_t count = ( argc > 2 ) ? atoi( argv[2] ) : 10;
+  double loss = ( argc > 3 ) ? atof( argv[3] ) : 0.05;
+  bool continuous = ( argc > 4 ) ? ( atoi( argv[4] ) != 0 ) : false;
+  int32_t offset = ( argc > 5 ) ? atoi( argv[5] ) * 1000 : 0;
+  uint8_t row = RangingCalibrationRow( LORA_BW_1600 );
+  uint8_t column = RangingCalibrationColumn( LORA_SF10 );
+  double maxDifference = 0.0;
+  SimChannel channel( 1 );
+  SX1280Sim master( &channel );
+  SX1280Sim slave( &channel );
+  ModulationParams_t modulationParams;
+  PacketParams_t packetParams;
+  uint32_t valid = 0;
+  uint32_t timeouts = 0;
+  double sum = 0.0;
+  uint64_t start;
+
+  channel.SetLoss( loss );
+  slave.SetPosition( distance, 0.0, 0.0 );
+  master.SetRangingError( 0.0, 0.5 );
+  master.SetRangingFeiGradient( RangingFeiGradients[row][column] / 1000.0 );
+  slave.SetFrequencyOffset( offset );
+  SlaveInit( &slave );
+
+  SimTransport_Attach( &channel, &master );
+  Radio.SetTransport( &SimTransport );
+  Radio.Init( &Callbacks );
+  Radio.SetRegulatorMode( USE_DCDC );
+
+  modulationParams.PacketType = PACKET_TYPE_RANGING;
+  modulationParams.Params.LoRa.SpreadingFactor = LORA_SF10;
+  modulationParams.Params.LoRa.Bandwidth = LORA_BW_1600;
+  modulationParams.Params.LoRa.CodingRate = LORA_CR_LI_4_5;
+
+  packetParams.PacketType = PACKET_TYPE_RANGING;
+  packetParams.Params.LoRa.PreambleLength = 12;
+  packetParams.Params.LoRa.HeaderType = LORA_PACKET_VARIABLE_LENGTH;
+  packetParams.Params.LoRa.PayloadLength = 7;
+  packetParams.Params.LoRa.Crc = LORA_CRC_ON;
+  packetParams.Params.LoRa.InvertIQ = LORA_IQ_NORMAL;
+
+  Radio.SetStandby( STDBY_RC );
+  Radio.SetPacketType( modulationParams.PacketType );
+  Radio.SetModulationParams( &modulationParams );
+  Radio.SetPacketParams( &packetParams );
+  Radio.SetRfFrequency( RF_FREQUENCY );
+  Radio.SetTxParams( TX_OUTPUT_POWER, RADIO_RAMP_20_US );
+  Radio.SetBufferBaseAddresses( 0x00, 0x00 );
+  if ( offset != 0 )
+  {
+    Radio.SetRangingProfile( LORA_BW_1600, LORA_SF10 );
+  }
+  else
+  {
+    Radio.SetRangingCalibration( RANGING_CALIBRATION );
+  }
+  Radio.SetRangingIdLength( RANGING_IDCHECK_LENGTH_32_BITS );
+  Radio.SetRangingRequestAddress( RANGING_ADDRESS );
+  Radio.SetDioIrqParams( IRQ_RANGING_MASTER_RESULT_VALID | IRQ_RANGING_MASTER_TIMEOUT,
+                         IRQ_RANGING_MASTER_RESULT_VALID | IRQ_RANGING_MASTER_TIMEOUT, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+
+  start = channel.Now( );
+  if ( continuous == true )
+  {
+    Radio.ResetContinuousRangingStats( );
+    Radio.StartContinuousRanging( ( TickTime_t ) {
+      RADIO_TICK_SIZE_1000_US, 0xFFFF
+    } );
+    while ( valid + timeouts < count )
+    {
+      RadioRangingSample_t sample;
+
+      Radio.WaitForIrq( 1000 );
+      Radio.Dispatch( );
+      while ( Radio.ReadRangingSample( &sample ) == true )
+      {
+        printf( "Measure %u: %.2f m\n", valid + timeouts + 1, sample.Distance / 256.0 );
+        sum += sample.Distance / 256.0;
+        valid++;
+      }
+      timeouts = Radio.GetContinuousRangingStats( ).Failed;
+    }
+    Radio.StopContinuousRanging( );
+    printf( "Re-arm latency mean %.0f us, max %u us\n", ( double )Radio.GetContinuousRangingStats( ).TotalRearm / ( valid + timeouts ),
+            Radio.GetContinuousRangingStats( ).MaxRearm );
+  }
+
+  for ( uint32_t i = 0; ( continuous == false ) && ( i < count ); i++ )
+  {
+    RangingDone = false;
+    Radio.SetTx( ( TickTime_t ) {
+      RADIO_TICK_SIZE_1000_US, 0xFFFF
+    } );
+    while ( RangingDone == false )
+    {
+      Radio.WaitForIrq( 1000 );
+      Radio.Dispatch( );
+    }
+    if ( ( RangingCode == IRQ_RANGING_MASTER_VALID_CODE ) && ( offset != 0 ) )
+    {
+      RadioRangingResult_t compensated = Radio.GetCompensatedRangingResult( RANGING_RESULT_RAW );
+      double demoFei = SlaveFrequencyError( &slave );
+      double demo = compensated.Raw / 256.0 - ( RangingFeiGradients[row][column] / 1000.0 ) * demoFei / 1000;
+      double result = compensated.Corrected / 256.0;
+
+      maxDifference = ( fabs( result - demo ) > maxDifference ) ? fabs( result - demo ) : maxDifference;
+      printf( "Measure %u: %.2f m, raw %.2f m, master %ld Hz, slave %.0f Hz, demo %.2f m\n", i + 1, result,
+              compensated.Raw / 256.0, ( long )compensated.Fei, demoFei, demo );
+      sum += result;
+      valid++;
+    }
+    else if ( RangingCode == IRQ_RANGING_MASTER_VALID_CODE )
+    {
+      double result = Radio.GetRangingResult( RANGING_RESULT_RAW );
+
+      printf( "Measure %u: %.2f m\n", i + 1, result );
+      sum += result;
+      valid++;
+    }
+    else
+    {
+      printf( "Measure %u: timeout\n", i + 1 );
+      timeouts++;
+    }
+  }
+
+  if ( offset != 0 )
+  {
+    printf( "Driver against the demo compensation: max difference %.1f mm\n", maxDifference * 1000.0 );
+  }
+  printf( "Distance %.2f m, mean %.2f m over %u measures, %u timeouts\n", distance, ( valid > 0 ) ? sum / valid : 0.0, valid, timeouts );
+  printf( "Simulated time %.3f s, %.1f measures/s, ignored commands %u\n", channel.Now( ) / 1e6,
+          ( valid + timeouts ) / ( ( channel.Now( ) - start ) / 1e6 ), master.GetIgnoredCommands( ) );
+  return ( ( master.GetIgnoredCommands( ) == 0 ) && ( maxDifference <= COMPENSATION_BOUND ) ) ? 0 : 1;
+}
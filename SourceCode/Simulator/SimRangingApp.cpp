@@ -0,0 +1,343 @@
+/*
+   Ranging application of the Arduino sketch as master node, run by the
+   driver on a simulated radio against a scripted slave node that follows
+   the same protocol. The slave node can go silent for one session to check
+   the master recovers on its timeouts.
+
+   Usage: SimRangingApp [ sessions [ distance [ loss [ stuck [ verbose ] ] ] ] ]
+          stuck is the session the slave node ignores, 0 for none
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Radio.h"
+#include "RangingApp.h"
+#include "SimTransport.h"
+
+#define RANGING_FREQUENCY                           2450000000// Hz, Channels[0] of FreqLUT.h
+#define RANGING_ADDRESS                             0x20012301
+#define MEASURES                                    10
+#define SWITCH_DELAY                                10000 // us
+#define MASTER_RETRIES                              3
+#define PEER_TIMEOUT                                3000000 // us
+
+typedef enum
+{
+  PEER_WAIT_CALIBRATION,
+  PEER_SLAVE,
+  PEER_SWITCH,
+  PEER_MASTER,
+  PEER_SEND_RESULT,
+  PEER_SILENT,
+} PeerStates_t;
+
+/*!
+   \brief Slave node of the ranging application, scripted with raw commands
+*/
+typedef struct
+{
+  SX1280Sim *Radio;
+  PeerStates_t State;
+  PeerStates_t NextState;
+  uint64_t SwitchAt;
+  uint64_t LastIrq;
+  uint8_t Session;
+  uint8_t Target;
+  uint8_t Measures;
+  uint8_t Retries;
+  int32_t Result;
+} Peer_t;
+
+static bool Verbose = false;
+
+static void PrintLine( const char *line )
+{
+  if ( Verbose == true )
+  {
+    printf( "  %s\n", line );
+  }
+}
+
+static void SetFrequency( SX1280Sim *radio, uint32_t frequency )
+{
+  uint32_t freq = ( uint32_t )( ( double )frequency / ( double )FREQ_STEP );
+  const uint8_t rfFrequency[] = { ( uint8_t )( freq >> 16 ), ( uint8_t )( freq >> 8 ), ( uint8_t )freq };
+
+  radio->Command( RADIO_SET_RFFREQUENCY, rfFrequency, sizeof( rfFrequency ) );
+}
+
+static void PeerLora( SX1280Sim *radio )
+{
+  const uint8_t packetType[] = { PACKET_TYPE_LORA };
+  const uint8_t modulationParams[] = { LORA_SF10, LORA_BW_1600, LORA_CR_LI_4_5 };
+  const uint8_t packetParams[] = { 12, LORA_PACKET_VARIABLE_LENGTH, RANGING_APP_MESSAGE_SIZE, LORA_CRC_ON, LORA_IQ_NORMAL, 0, 0 };
+  const uint8_t standby[] = { STDBY_RC };
+
+  radio->Command( RADIO_SET_STANDBY, standby, sizeof( standby ) );
+  radio->Command( RADIO_SET_PACKETTYPE, packetType, sizeof( packetType ) );
+  radio->Command( RADIO_SET_MODULATIONPARAMS, modulationParams, sizeof( modulationParams ) );
+  radio->Command( RADIO_SET_PACKETPARAMS, packetParams, sizeof( packetParams ) );
+  SetFrequency( radio, RANGING_FREQUENCY );
+}
+
+static void PeerLoraRx( Peer_t *peer )
+{
+  const uint8_t rxSingle[] = { RADIO_TICK_SIZE_1000_US, 0x00, 0x00 };
+
+  PeerLora( peer->Radio );
+  peer->Radio->Command( RADIO_SET_RX, rxSingle, sizeof( rxSingle ) );
+  peer->State = PEER_WAIT_CALIBRATION;
+}
+
+static void PeerRangingInit( Peer_t *peer, uint16_t calibration )
+{
+  SX1280Sim *radio = peer->Radio;
+  const uint8_t packetType[] = { PACKET_TYPE_RANGING };
+  const uint8_t modulationParams[] = { LORA_SF10, LORA_BW_1600, LORA_CR_LI_4_5 };
+  const uint8_t packetParams[] = { 12, LORA_PACKET_VARIABLE_LENGTH, 7, LORA_CRC_ON, LORA_IQ_NORMAL, 0, 0 };
+  const uint8_t idLength[] = { REG_LR_RANGINGIDCHECKLENGTH >> 8, REG_LR_RANGINGIDCHECKLENGTH & 0xFF, RANGING_IDCHECK_LENGTH_32_BITS << 6 };
+
+  radio->Command( RADIO_SET_PACKETTYPE, packetType, sizeof( packetType ) );
+  radio->Command( RADIO_SET_MODULATIONPARAMS, modulationParams, sizeof( modulationParams ) );
+  radio->Command( RADIO_SET_PACKETPARAMS, packetParams, sizeof( packetParams ) );
+  SetFrequency( radio, RANGING_FREQUENCY );
+  radio->Command( RADIO_WRITE_REGISTER, idLength, sizeof( idLength ) );
+  for ( uint8_t i = 0; i < 2; i++ )
+  {
+    uint16_t reg = ( i == 0 ) ? REG_LR_DEVICERANGINGADDR : REG_LR_REQUESTRANGINGADDR;
+    const uint8_t address[] = { ( uint8_t )( reg >> 8 ), ( uint8_t )reg,
+                                ( RANGING_ADDRESS >> 24 ) & 0xFF, ( RANGING_ADDRESS >> 16 ) & 0xFF, ( RANGING_ADDRESS >> 8 ) & 0xFF, RANGING_ADDRESS & 0xFF
+                              };
+
+    radio->Command( RADIO_WRITE_REGISTER, address, sizeof( address ) );
+  }
+  const uint8_t calib[] = { REG_LR_RANGINGRERXTXDELAYCAL >> 8, REG_LR_RANGINGRERXTXDELAYCAL & 0xFF,
+                            ( uint8_t )( calibration >> 8 ), ( uint8_t )calibration
+                          };
+  radio->Command( RADIO_WRITE_REGISTER, calib, sizeof( calib ) );
+  peer->Measures = 0;
+  peer->Retries = 0;
+}
+
+static void PeerSlave( Peer_t *peer )
+{
+  const uint8_t role[] = { RADIO_RANGING_ROLE_SLAVE };
+  const uint8_t rxContinuous[] = { RADIO_TICK_SIZE_1000_US, 0xFF, 0xFF };
+
+  peer->Radio->Command( RADIO_SET_RANGING_ROLE, role, sizeof( role ) );
+  peer->Radio->Command( RADIO_SET_RX, rxContinuous, sizeof( rxContinuous ) );
+  peer->State = PEER_SLAVE;
+}
+
+static void PeerMaster( Peer_t *peer )
+{
+  const uint8_t role[] = { RADIO_RANGING_ROLE_MASTER };
+  const uint8_t tx[] = { RADIO_TICK_SIZE_1000_US, 0x00, 100 };
+
+  peer->Radio->Command( RADIO_SET_RANGING_ROLE, role, sizeof( role ) );
+  peer->Radio->Command( RADIO_SET_TX, tx, sizeof( tx ) );
+  peer->State = PEER_MASTER;
+}
+
+static void PeerSwitch( Peer_t *peer, PeerStates_t next, uint64_t now )
+{
+  peer->State = PEER_SWITCH;
+  peer->NextState = next;
+  peer->SwitchAt = now + SWITCH_DELAY;
+}
+
+static void PeerRun( Peer_t *peer, uint64_t now )
+{
+  SX1280Sim *radio = peer->Radio;
+  uint16_t irq = radio->GetIrqStatus( );
+  RangingAppMessage_t message;
+
+  radio->ClearIrqStatus( IRQ_RADIO_ALL );
+  if ( irq != 0 )
+  {
+    peer->LastIrq = now;
+  }
+  switch ( peer->State )
+  {
+    case PEER_WAIT_CALIBRATION:
+      if ( ( irq & IRQ_RX_DONE ) && !( irq & IRQ_CRC_ERROR ) &&
+           ( RangingAppDecode( radio->GetBuffer( ) + radio->GetRxStartBufferPointer( ), radio->GetRxPayloadLength( ), &message ) == true ) &&
+           ( message.Type == RANGING_APP_MESSAGE_START ) )
+      {
+        peer->Session = message.Session;
+        peer->Target = message.Measures;
+        PeerRangingInit( peer, message.Calibration );
+        PeerSlave( peer );
+      }
+      else if ( irq & ( IRQ_RX_DONE | IRQ_RX_TX_TIMEOUT | IRQ_CRC_ERROR ) )
+      {
+        PeerLoraRx( peer );
+      }
+      break;
+
+    case PEER_SLAVE:
+      if ( irq & IRQ_RANGING_SLAVE_RESPONSE_DONE )
+      {
+        PeerSwitch( peer, PEER_MASTER, now );
+      }
+      else if ( now - peer->LastIrq > PEER_TIMEOUT )
+      {
+        PeerLoraRx( peer );
+      }
+      break;
+
+    case PEER_SWITCH:
+      if ( now < peer->SwitchAt )
+      {
+        break;
+      }
+      if ( peer->NextState == PEER_MASTER )
+      {
+        PeerMaster( peer );
+      }
+      else
+      {
+        uint8_t payload[1 + RANGING_APP_MESSAGE_SIZE] = { 0x00 };
+        const uint8_t tx[] = { RADIO_TICK_SIZE_1000_US, 0x00, 100 };
+
+        message.Type = RANGING_APP_MESSAGE_RESULT;
+        message.Session = peer->Session;
+        message.Measures = peer->Measures;
+        message.Calibration = 0;
+        message.Distance = peer->Result;
+        RangingAppEncode( &message, payload + 1 );
+        PeerLora( radio );
+        radio->Command( RADIO_WRITE_BUFFER, payload, sizeof( payload ) );
+        radio->Command( RADIO_SET_TX, tx, sizeof( tx ) );
+        peer->State = PEER_SEND_RESULT;
+      }
+      break;
+
+    case PEER_MASTER:
+      if ( irq & IRQ_RANGING_MASTER_RESULT_VALID )
+      {
+        peer->Retries = 0;
+        if ( ++peer->Measures >= peer->Target )
+        {
+          PeerSwitch( peer, PEER_SEND_RESULT, now );
+        }
+        else
+        {
+          PeerSlave( peer );
+        }
+      }
+      else if ( irq & IRQ_RANGING_MASTER_TIMEOUT )
+      {
+        if ( ++peer->Retries >= MASTER_RETRIES )
+        {
+          peer->Retries = 0;
+          PeerSlave( peer );
+        }
+        else
+        {
+          PeerMaster( peer );
+        }
+      }
+      break;
+
+    case PEER_SEND_RESULT:
+      if ( irq & ( IRQ_TX_DONE | IRQ_RX_TX_TIMEOUT ) )
+      {
+        PeerLoraRx( peer );
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t sessions = ( argc > 1 ) ? atoi( argv[1] ) : 5;
+  double distance = ( argc > 2 ) ? atof( argv[2] ) : 25.0;
+  double loss = ( argc > 3 ) ? atof( argv[3] ) : 0.05;
+  uint32_t stuck = ( argc > 4 ) ? atoi( argv[4] ) : 3;
+  SimChannel channel( 1 );
+  SX1280Sim master( &channel );
+  SX1280Sim slave( &channel );
+  Peer_t peer = { &slave, PEER_WAIT_CALIBRATION, PEER_WAIT_CALIBRATION, 0, 0, 0, 0, 0, 0, ( int32_t )( distance * 100.0 + 0.5 ) };
+  RangingAppConfig_t config = { true, RANGING_ADDRESS, MEASURES, PrintLine };
+  uint32_t started = 0;
+  uint32_t results = 0;
+  uint32_t setup = 0;
+  uint32_t teardown = 0;
+  uint64_t calls = 0;
+
+  Verbose = ( argc > 5 ) && ( atoi( argv[5] ) != 0 );
+  channel.SetLoss( loss );
+  slave.SetPosition( distance, 0.0, 0.0 );
+  master.SetRangingError( 0.0, 0.5 );
+  const uint8_t irqParams[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+  slave.Command( RADIO_SET_DIOIRQPARAMS, irqParams, sizeof( irqParams ) );
+  PeerLoraRx( &peer );
+
+  SimTransport_Attach( &channel, &master );
+  Radio.SetTransport( &SimTransport );
+  Radio.Init( NULL );
+  Radio.SetRegulatorMode( USE_DCDC );
+  RangingAppInit( &config, channel.Now( ) / 1000 );
+
+  // Main loop spinning every 100 us, the application never waits
+  while ( true )
+  {
+    uint32_t now = channel.Now( ) / 1000;
+
+    if ( RangingAppGetState( ) == RANGING_APP_IDLE )
+    {
+      RangingAppStats_t stats = RangingAppGetStats( );
+
+      if ( started > 0 )
+      {
+        if ( stats.Results > results )
+        {
+          printf( "Session %u: %.2f m in %u ms, setup %u ms, teardown %u ms\n", started, stats.Distance / 100.0, stats.Duration,
+                  stats.Setup, stats.Teardown );
+          setup += stats.Setup;
+          teardown += stats.Teardown;
+        }
+        else
+        {
+          printf( "Session %u: aborted after %u ms\n", started, stats.Duration );
+        }
+        results = stats.Results;
+      }
+      if ( started == sessions )
+      {
+        break;
+      }
+      started++;
+      if ( started == stuck )
+      {
+        const uint8_t standby[] = { STDBY_RC };
+
+        slave.Command( RADIO_SET_STANDBY, standby, sizeof( standby ) );
+        peer.State = PEER_SILENT;
+      }
+      else if ( peer.State == PEER_SILENT )
+      {
+        PeerLoraRx( &peer );
+      }
+      RangingAppStart( 0, now );
+    }
+    RangingAppRun( now );
+    PeerRun( &peer, channel.Now( ) );
+    channel.Advance( 100 );
+    calls++;
+  }
+
+  RangingAppStats_t stats = RangingAppGetStats( );
+
+  printf( "%u sessions, %u results, %u state timeouts, %llu loop iterations, ignored commands %u\n", stats.Sessions, stats.Results,
+          stats.Timeouts, ( unsigned long long )calls, master.GetIgnoredCommands( ) );
+  if ( stats.Results > 0 )
+  {
+    printf( "Mean setup %.1f ms, mean teardown %.1f ms\n", ( double )setup / stats.Results, ( double )teardown / stats.Results );
+  }
+  return ( master.GetIgnoredCommands( ) == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/*
+   Host time spent aggregating ranging samples, with the bubble sort and
+   median the DevKit demo runs once the last sample is in, and with the
+   driver statistics updated as each sample arrives.
+
+   Usage: SimRangingStats [ runs ]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "Radio.h"
+
+#define DISTANCE                                    25.0 // m
+#define DEVIATION                                   0.5 // m
+#define OUTLIERS                                    10 // %
+
+static const uint8_t Sizes[] = { 10, 20, 50, 100, 200, 255 };
+
+static double Now( void )
+{
+  struct timespec time;
+
+  clock_gettime( CLOCK_MONOTONIC, &time );
+  return time.tv_sec * 1e6 + time.tv_nsec / 1e3;
+}
+
+static double Gaussian( void )
+{
+  double u1 = ( rand( ) + 1.0 ) / ( RAND_MAX + 2.0 );
+  double u2 = ( rand( ) + 1.0 ) / ( RAND_MAX + 2.0 );
+
+  return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+static void Draw( double *samples, int8_t *rssi, uint8_t count )
+{
+  for ( uint8_t i = 0; i < count; i++ )
+  {
+    if ( ( rand( ) % 100 ) < OUTLIERS )
+    {
+      samples[i] = -50.0 + 250.0 * rand( ) / RAND_MAX;
+    }
+    else
+    {
+      samples[i] = DISTANCE + DEVIATION * Gaussian( );
+    }
+    rssi[i] = -90 + rand( ) % 30;
+  }
+}
+
+/*!
+   \brief Median as computed by CheckDistance( ) before the statistics
+*/
+static double BubbleMedian( double *samples, uint8_t count )
+{
+  for ( int i = count - 1; i > 0; --i )
+  {
+    for ( int j = 0; j < i; ++j )
+    {
+      if ( samples[j] > samples[j + 1] )
+      {
+        double temp = samples[j];
+
+        samples[j] = samples[j + 1];
+        samples[j + 1] = temp;
+      }
+    }
+  }
+  if ( ( count % 2 ) == 0 )
+  {
+    return ( samples[count / 2] + samples[count / 2 - 1] ) / 2.0;
+  }
+  return samples[count / 2];
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t runs = ( argc > 1 ) ? atoi( argv[1] ) : 1000;
+  static RadioRangingStats_t stats;
+  double samples[255];
+  int8_t rssi[255];
+
+  srand( 1 );
+  printf( "%8s %14s %14s %14s %10s %10s %9s\n", "samples", "sort [us]", "add [us]", "result [us]", "sorted [m]", "stats [m]", "accepted" );
+  for ( uint8_t s = 0; s < sizeof( Sizes ); s++ )
+  {
+    uint8_t count = Sizes[s];
+    double sortTime = 0.0;
+    double addTime = 0.0;
+    double resultTime = 0.0;
+    double sortedMedian = 0.0;
+    double statsMedian = 0.0;
+    uint32_t accepted = 0;
+
+    for ( uint32_t r = 0; r < runs; r++ )
+    {
+      RadioRangingStatsResult_t result;
+      double start;
+
+      Draw( samples, rssi, count );
+
+      Radio.RangingStatsReset( &stats );
+      start = Now( );
+      for ( uint8_t i = 0; i < count; i++ )
+      {
+        Radio.RangingStatsAdd( &stats, ( int32_t )floor( samples[i] * 256.0 + 0.5 ), rssi[i] );
+      }
+      addTime += Now( ) - start;
+
+      start = Now( );
+      Radio.RangingStatsGetResult( &stats, 10, &result );
+      resultTime += Now( ) - start;
+
+      start = Now( );
+      sortedMedian += BubbleMedian( samples, count );
+      sortTime += Now( ) - start;
+
+      statsMedian += result.Median / 256.0;
+      accepted += result.Accepted;
+    }
+    printf( "%8u %14.3f %14.3f %14.3f %10.2f %10.2f %9.1f\n", count, sortTime / runs, addTime / runs / count, resultTime / runs,
+            sortedMedian / runs, statsMedian / runs, ( double )accepted / runs );
+  }
+  return 0;
+}
@@ -0,0 +1,204 @@
+/*
+   Transactions and simulated host time spent reading a received packet,
+   with the separate calls a receiver makes today and with ReadRxFrame( ).
+
+   Usage: SimRxFrame [ packets ]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Radio.h"
+#include "SimTransport.h"
+
+#define RF_FREQUENCY                                2400000000// Hz
+#define PAYLOAD_SIZE                                32
+
+static RadioCallbacks_t Callbacks = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
+typedef struct
+{
+  const char *Name;
+  ModulationParams_t ModulationParams;
+  PacketParams_t PacketParams;
+} Modem_t;
+
+typedef struct
+{
+  uint32_t Transactions;
+  uint64_t Time;
+  uint32_t Packets;
+} Cost_t;
+
+static void PeerInit( SX1280Sim *radio, const Modem_t *modem )
+{
+  uint32_t freq = ( uint32_t )( ( double )RF_FREQUENCY / ( double )FREQ_STEP );
+  const uint8_t standby[] = { STDBY_RC };
+  const uint8_t packetType[] = { modem->ModulationParams.PacketType };
+  const uint8_t rfFrequency[] = { ( uint8_t )( freq >> 16 ), ( uint8_t )( freq >> 8 ), ( uint8_t )freq };
+  const uint8_t baseAddresses[] = { 0x00, 0x00 };
+  uint8_t modulationParams[3];
+  uint8_t packetParams[7];
+
+  if ( modem->ModulationParams.PacketType == PACKET_TYPE_FLRC )
+  {
+    modulationParams[0] = modem->ModulationParams.Params.Flrc.BitrateBandwidth;
+    modulationParams[1] = modem->ModulationParams.Params.Flrc.CodingRate;
+    modulationParams[2] = modem->ModulationParams.Params.Flrc.ModulationShaping;
+    packetParams[0] = modem->PacketParams.Params.Flrc.PreambleLength;
+    packetParams[1] = modem->PacketParams.Params.Flrc.SyncWordLength;
+    packetParams[2] = modem->PacketParams.Params.Flrc.SyncWordMatch;
+    packetParams[3] = modem->PacketParams.Params.Flrc.HeaderType;
+    packetParams[4] = modem->PacketParams.Params.Flrc.PayloadLength;
+    packetParams[5] = modem->PacketParams.Params.Flrc.CrcLength;
+    packetParams[6] = modem->PacketParams.Params.Flrc.Whitening;
+  }
+  else
+  {
+    modulationParams[0] = modem->ModulationParams.Params.LoRa.SpreadingFactor;
+    modulationParams[1] = modem->ModulationParams.Params.LoRa.Bandwidth;
+    modulationParams[2] = modem->ModulationParams.Params.LoRa.CodingRate;
+    packetParams[0] = modem->PacketParams.Params.LoRa.PreambleLength;
+    packetParams[1] = modem->PacketParams.Params.LoRa.HeaderType;
+    packetParams[2] = modem->PacketParams.Params.LoRa.PayloadLength;
+    packetParams[3] = modem->PacketParams.Params.LoRa.Crc;
+    packetParams[4] = modem->PacketParams.Params.LoRa.InvertIQ;
+    packetParams[5] = 0;
+    packetParams[6] = 0;
+  }
+  radio->Command( RADIO_SET_STANDBY, standby, sizeof( standby ) );
+  radio->Command( RADIO_SET_PACKETTYPE, packetType, sizeof( packetType ) );
+  radio->Command( RADIO_SET_MODULATIONPARAMS, modulationParams, sizeof( modulationParams ) );
+  radio->Command( RADIO_SET_PACKETPARAMS, packetParams, sizeof( packetParams ) );
+  radio->Command( RADIO_SET_RFFREQUENCY, rfFrequency, sizeof( rfFrequency ) );
+  radio->Command( RADIO_SET_BUFFERBASEADDRESS, baseAddresses, sizeof( baseAddresses ) );
+}
+
+static void PeerSend( SX1280Sim *radio, uint8_t counter )
+{
+  uint8_t frame[1 + PAYLOAD_SIZE];
+  const uint8_t tx[] = { RADIO_TICK_SIZE_1000_US, 0x00, 0x00 };
+
+  frame[0] = 0x00;
+  for ( uint8_t i = 0; i < PAYLOAD_SIZE; i++ )
+  {
+    frame[1 + i] = counter + i;
+  }
+  radio->Command( RADIO_WRITE_BUFFER, frame, sizeof( frame ) );
+  radio->Command( RADIO_SET_TX, tx, sizeof( tx ) );
+}
+
+static void ReceiverInit( const Modem_t *modem )
+{
+  ModulationParams_t modulationParams = modem->ModulationParams;
+  PacketParams_t packetParams = modem->PacketParams;
+
+  Radio.SetStandby( STDBY_RC );
+  Radio.SetPacketType( modulationParams.PacketType );
+  Radio.SetModulationParams( &modulationParams );
+  Radio.SetPacketParams( &packetParams );
+  Radio.SetRfFrequency( RF_FREQUENCY );
+  Radio.SetBufferBaseAddresses( 0x00, 0x00 );
+  Radio.SetDioIrqParams( IRQ_RX_DONE | IRQ_CRC_ERROR, IRQ_RX_DONE | IRQ_CRC_ERROR, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+  Radio.SetRx( ( TickTime_t ) {
+    RADIO_TICK_SIZE_1000_US, 0xFFFF
+  } );
+}
+
+static void ReadSeparately( uint8_t *payload )
+{
+  PacketStatus_t packetStatus;
+  uint8_t size;
+
+  Radio.GetIrqStatus( );
+  Radio.GetPayload( payload, &size, 255 );
+  Radio.GetPacketStatus( &packetStatus );
+  Radio.GetFrequencyError( );
+}
+
+static void ReadAtOnce( uint8_t *payload )
+{
+  RadioRxFrame_t frame;
+
+  Radio.ReadRxFrame( &frame, payload, 255 );
+}
+
+static void Measure( SimChannel *channel, SX1280Sim *peer, uint32_t packets, void ( *read )( uint8_t *payload ), Cost_t *cost )
+{
+  uint8_t payload[255];
+
+  for ( uint32_t i = 0; i < packets; i++ )
+  {
+    PeerSend( peer, ( uint8_t )i );
+    if ( Radio.WaitForIrq( 1000 ) == false )
+    {
+      continue;
+    }
+
+    uint32_t transactions = Radio.GetSpiTransactionCount( );
+    uint64_t start = channel->Now( );
+
+    read( payload );
+    cost->Transactions += Radio.GetSpiTransactionCount( ) - transactions;
+    cost->Time += channel->Now( ) - start;
+    cost->Packets++;
+    Radio.ClearIrqStatus( IRQ_RADIO_ALL );
+    channel->RunUntil( channel->Now( ) + 1000 );
+  }
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t packets = ( argc > 1 ) ? atoi( argv[1] ) : 100;
+  SimChannel channel( 1 );
+  SX1280Sim receiver( &channel );
+  SX1280Sim peer( &channel );
+  Modem_t modems[2];
+
+  modems[0].Name = "LoRa SF7";
+  modems[0].ModulationParams.PacketType = PACKET_TYPE_LORA;
+  modems[0].ModulationParams.Params.LoRa.SpreadingFactor = LORA_SF7;
+  modems[0].ModulationParams.Params.LoRa.Bandwidth = LORA_BW_1600;
+  modems[0].ModulationParams.Params.LoRa.CodingRate = LORA_CR_4_5;
+  modems[0].PacketParams.PacketType = PACKET_TYPE_LORA;
+  modems[0].PacketParams.Params.LoRa.PreambleLength = 12;
+  modems[0].PacketParams.Params.LoRa.HeaderType = LORA_PACKET_VARIABLE_LENGTH;
+  modems[0].PacketParams.Params.LoRa.PayloadLength = PAYLOAD_SIZE;
+  modems[0].PacketParams.Params.LoRa.Crc = LORA_CRC_ON;
+  modems[0].PacketParams.Params.LoRa.InvertIQ = LORA_IQ_NORMAL;
+
+  modems[1].Name = "FLRC 1.3 Mb/s";
+  modems[1].ModulationParams.PacketType = PACKET_TYPE_FLRC;
+  modems[1].ModulationParams.Params.Flrc.BitrateBandwidth = FLRC_BR_1_300_BW_1_2;
+  modems[1].ModulationParams.Params.Flrc.CodingRate = FLRC_CR_1_2;
+  modems[1].ModulationParams.Params.Flrc.ModulationShaping = RADIO_MOD_SHAPING_BT_0_5;
+  modems[1].PacketParams.PacketType = PACKET_TYPE_FLRC;
+  modems[1].PacketParams.Params.Flrc.PreambleLength = PREAMBLE_LENGTH_32_BITS;
+  modems[1].PacketParams.Params.Flrc.SyncWordLength = FLRC_SYNCWORD_LENGTH_4_BYTE;
+  modems[1].PacketParams.Params.Flrc.SyncWordMatch = RADIO_RX_MATCH_SYNCWORD_1;
+  modems[1].PacketParams.Params.Flrc.HeaderType = RADIO_PACKET_VARIABLE_LENGTH;
+  modems[1].PacketParams.Params.Flrc.PayloadLength = PAYLOAD_SIZE;
+  modems[1].PacketParams.Params.Flrc.CrcLength = RADIO_CRC_2_BYTES;
+  modems[1].PacketParams.Params.Flrc.Whitening = RADIO_WHITENING_OFF;
+
+  SimTransport_Attach( &channel, &receiver );
+  Radio.SetTransport( &SimTransport );
+  Radio.Init( &Callbacks );
+
+  printf( "%-14s %-12s %8s %14s %12s\n", "modem", "read", "packets", "transactions", "time [us]" );
+  for ( uint8_t m = 0; m < 2; m++ )
+  {
+    Cost_t separate = { 0, 0, 0 };
+    Cost_t atOnce = { 0, 0, 0 };
+
+    PeerInit( &peer, &modems[m] );
+    ReceiverInit( &modems[m] );
+    Measure( &channel, &peer, packets, ReadSeparately, &separate );
+    Measure( &channel, &peer, packets, ReadAtOnce, &atOnce );
+
+    printf( "%-14s %-12s %8u %14.1f %12.1f\n", modems[m].Name, "separate", separate.Packets,
+            ( double )separate.Transactions / ( separate.Packets ? separate.Packets : 1 ), ( double )separate.Time / ( separate.Packets ? separate.Packets : 1 ) );
+    printf( "%-14s %-12s %8u %14.1f %12.1f\n", modems[m].Name, "ReadRxFrame", atOnce.Packets,
+            ( double )atOnce.Transactions / ( atOnce.Packets ? atOnce.Packets : 1 ), ( double )atOnce.Time / ( atOnce.Packets ? atOnce.Packets : 1 ) );
+  }
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+   Fixed-point ranging conversions against the double code they replaced:
+   the raw register to Q24.8 meters of the driver, and the short range
+   correction with its coefficients in Q27.36, both in the driver and in
+   the DevKit demo (RangingCorrection.h).
+
+   The raw conversion is checked on every 24-bit register value for each
+   LoRa bandwidth, the correction on every 1/256 m step of the range it
+   applies to for every RSSI. The largest errors must stay within one
+   Q24.8 step, and both corrections must agree bit for bit.
+
+   Usage: SimShortRange
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Radio.h"
+#include "RangingCorrection.h"
+
+// Internal of the driver, not part of Radio_t
+int32_t RangingRawToQ8(int32_t raw);
+
+#define ERROR_BOUND                                 ( 1.0 / 256.0 ) // m, one Q24.8 step
+
+/*!
+   \brief Short range correction coefficients, as the double code had them
+*/
+static const double t0 = -0.016432807883697;
+static const double t1 = 0.323147003165358;
+static const double t2 = 0.014922061351196;
+static const double t3 = 0.000137832006285;
+static const double t4 = 0.536873856625399;
+static const double t5 = 0.040890089178579;
+static const double t6 = -0.001074801048732;
+static const double t7 = 0.000009240142234;
+
+static double CorrectionDouble( double distance, int8_t rssi )
+{
+  return t0 + t1 * rssi + t2 * pow( rssi, 2 ) + t3 * pow( rssi, 3 ) +
+         t4 * distance + t5 * pow( distance, 2 ) + t6 * pow( distance, 3 ) + t7 * pow( distance, 4 );
+}
+
+static int32_t Complement2( uint32_t num, uint8_t bitCnt )
+{
+  int32_t retVal = ( int32_t )num;
+
+  if ( num >= ( 1UL << ( bitCnt - 1 ) ) )
+  {
+    retVal -= ( int32_t )( 1UL << bitCnt );
+  }
+  return retVal;
+}
+
+static void SetBandwidth( RadioLoRaBandwidths_t bandwidth )
+{
+  ModulationParams_t modulationParams;
+
+  modulationParams.PacketType = PACKET_TYPE_RANGING;
+  modulationParams.Params.LoRa.SpreadingFactor = LORA_SF8;
+  modulationParams.Params.LoRa.Bandwidth = bandwidth;
+  modulationParams.Params.LoRa.CodingRate = LORA_CR_4_5;
+  Radio.SetPacketType( PACKET_TYPE_RANGING );
+  Radio.SetModulationParams( &modulationParams );
+}
+
+int main( void )
+{
+  const RadioLoRaBandwidths_t bandwidths[] = { LORA_BW_0200, LORA_BW_0400, LORA_BW_0800, LORA_BW_1600 };
+  const char *bandwidthNames[] = { "200", "400", "800", "1600" };
+  const double bandwidthHz[] = { 203125.0, 406250.0, 812500.0, 1625000.0 };
+  double maxCorrection = 0.0;
+  int32_t worstDistance = 0;
+  int8_t worstRssi = 0;
+  uint32_t disagreements = 0;
+  uint32_t outside = 0;
+  bool pass = true;
+
+  Radio.SetTransport( &LoopbackTransport );
+  Radio.Init( NULL );
+
+  // Raw register to Q24.8 meters, the bandwidth coming from the modulation
+  for ( uint8_t i = 0; i < sizeof( bandwidths ) / sizeof( bandwidths[0] ); i++ )
+  {
+    double maxRaw = 0.0;
+
+    SetBandwidth( bandwidths[i] );
+    for ( uint32_t reg = 0; reg < ( 1UL << 24 ); reg++ )
+    {
+      int32_t raw = Complement2( reg, 24 );
+      double reference = ( double )raw / bandwidthHz[i] * 36621.09375;
+      double error = fabs( RangingRawToQ8( raw ) / 256.0 - reference );
+
+      maxRaw = ( error > maxRaw ) ? error : maxRaw;
+    }
+    printf( "Raw BW %4s kHz: max error %.2f mm over 2^24 registers\n", bandwidthNames[i], maxRaw * 1000.0 );
+    pass = pass && ( maxRaw <= ERROR_BOUND );
+  }
+
+  // Short range correction, every Q24.8 distance of [ -128, 50 ] m and RSSI
+  for ( int32_t distance = -128 * 256; distance <= 50 * 256; distance++ )
+  {
+    for ( int16_t rssi = -128; rssi <= 127; rssi++ )
+    {
+      int32_t driver = Radio.RangingShortRangeCorrection( distance, ( int8_t )rssi );
+      int32_t demo = ShortRangeCorrection( distance, ( int8_t )rssi );
+      double error = fabs( driver / 256.0 - CorrectionDouble( distance / 256.0, ( int8_t )rssi ) );
+
+      disagreements += ( driver != demo );
+      if ( error > maxCorrection )
+      {
+        maxCorrection = error;
+        worstDistance = distance;
+        worstRssi = ( int8_t )rssi;
+      }
+    }
+  }
+  printf( "Correction: max error %.2f mm at %.4f m, %d dBm, driver and demo differ %u times\n",
+          maxCorrection * 1000.0, worstDistance / 256.0, worstRssi, disagreements );
+  pass = pass && ( maxCorrection <= ERROR_BOUND ) && ( disagreements == 0 );
+
+  // Outside of the fitted range the distance is left alone
+  for ( int32_t distance = -1000 * 256; distance <= 1000 * 256; distance += 64 )
+  {
+    if ( ( distance < -128 * 256 ) || ( distance > 50 * 256 ) )
+    {
+      outside += ( Radio.RangingShortRangeCorrection( distance, -60 ) != distance ) || ( ShortRangeCorrection( distance, -60 ) != distance );
+    }
+  }
+  printf( "Outside [ -128, 50 ] m: %u distances changed\n", outside );
+  pass = pass && ( outside == 0 );
+
+  printf( "%s, bound %.2f mm\n", pass ? "PASS" : "FAIL", ERROR_BOUND * 1000.0 );
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#include <stddef.h>
+#include "SimTransport.h"
+
+static SimChannel *__Channel = NULL;
+static SX1280Sim *__Radio = NULL;
+static RadioIrqHandler_t __IrqHandler = NULL;
+
+static void SimOnDio1(void)
+{
+  if (__IrqHandler != NULL)
+  {
+    __IrqHandler();
+  }
+}
+
+static bool SimInit(void)
+{
+  return true;
+}
+
+static void SimReset(void)
+{
+  __Radio->Reset();
+}
+
+static void SimTransfer(uint8_t *frame, uint16_t size)
+{
+  __Radio->Transfer(frame, size);
+  // 1 us per byte, as with an 8 MHz SPI clock
+  __Channel->Advance(size);
+}
+
+static void SimChipSelect(bool select)
+{
+}
+
+static bool SimReadBusy(void)
+{
+  return __Radio->GetBusy();
+}
+
+static uint8_t SimReadDio(void)
+{
+  return __Radio->GetDio();
+}
+
+static void SimAttachIrq(RadioIrqHandler_t handler)
+{
+  __IrqHandler = handler;
+}
+
+static bool SimWaitForIrq(uint32_t timeout)
+{
+  uint64_t deadline = __Channel->Now() + ( uint64_t )timeout * 1000;
+
+  // Jump from event to event, the handler runs on the DIO1 edge
+  while (((__Radio->GetDio() & 0x02) == 0) && (__Channel->Now() < deadline))
+  {
+    uint64_t next = __Channel->GetNextEvent();
+
+    __Channel->RunUntil((next < deadline) ? next : deadline);
+  }
+  return (__Radio->GetDio() & 0x02) != 0;
+}
+
+static uint32_t SimGetTime(void)
+{
+  return ( uint32_t )__Channel->Now();
+}
+
+static void SimYield(void)
+{
+  __Channel->Advance(1);
+}
+
+static void SimSleep(uint32_t time)
+{
+  __Channel->Advance(time);
+}
+
+void SimTransport_Attach(SimChannel *channel, SX1280Sim *radio)
+{
+  __Channel = channel;
+  __Radio = radio;
+  __Radio->SetDio1Handler(SimOnDio1);
+}
+
+const RadioTransport_t SimTransport = {
+  SimInit,
+  SimReset,
+  SimTransfer,
+  SimChipSelect,
+  SimReadBusy,
+  SimReadDio,
+  SimAttachIrq,
+  SimWaitForIrq,
+  SimGetTime,
+  SimYield,
+  SimSleep
+};
@@ -0,0 +1,27 @@
+#ifndef __SIM_TRANSPORT_H__
+#define __SIM_TRANSPORT_H__
+
+#include "Transport.h"
+#include "SimChannel.h"
+#include "SX1280Sim.h"
+
+/*!
+   \brief Transport running the driver against a simulated radio
+
+   The simulated time only moves when the driver talks to the radio or
+   waits: a transfer advances it by 1 us per byte (8 MHz SPI clock),
+   Yield( ) by 1 us, Sleep( ) by the requested time and WaitForIrq( ) up to
+   the next DIO1 edge. The DIO1 handler is run from within these calls, as
+   an interrupt would.
+
+   \remark Select it with Radio.SetTransport( &SimTransport ) after
+           SimTransport_Attach( ) and before Radio.Init( )
+*/
+extern const RadioTransport_t SimTransport;
+
+/*!
+   \brief Connects the transport to a simulated radio and its channel
+*/
+void SimTransport_Attach( SimChannel *channel, SX1280Sim *radio );
+
+#endif /* __SIM_TRANSPORT_H__ */
@@ -0,0 +1,160 @@
+/*
+   Turnaround after a TX done interrupt, with and without the lazy busy
+   mode of the driver.
+
+   TX to RX: on TX done the node switches to RX for the reply, then the
+   application spends the host work on the frame it sent. TX to TX: on TX
+   done the application fills the next payload, at 1 us per byte, sends it
+   and then spends the host work.
+
+   For each, the time from the DIO1 edge to the radio being ready (BUSY
+   falling after SetRx or SetTx), and to the application being done, as
+   the host would see them. The host only spends simulated time on the SPI
+   bus, on BUSY polling and on the modelled work.
+
+   Usage: SimTurnaround [ cycles [ host work us ] ]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Radio.h"
+#include "SimTransport.h"
+
+#define RF_FREQUENCY                                2400000000// Hz
+#define TX_OUTPUT_POWER                             13 // dBm
+#define TX_TIMEOUT_VALUE                            100 // ms
+#define RX_TIMEOUT_VALUE                            10 // ms
+#define PAYLOAD_SIZE                                32
+
+typedef struct
+{
+  uint64_t Ready;                                         //!< DIO1 edge to the radio in RX or TX [us]
+  uint64_t Done;                                          //!< DIO1 edge to the end of the host work [us]
+  uint32_t IgnoredCommands;
+} Turnaround_t;
+
+static SimChannel Channel( 1 );
+static SX1280Sim Node( &Channel );
+static uint8_t Payload[PAYLOAD_SIZE];
+
+/*!
+   \brief Waits for the end of the frame on air, returns the DIO1 edge
+*/
+static uint32_t WaitTxDone( void )
+{
+  RadioEvent_t event;
+
+  while ( true )
+  {
+    Radio.WaitForIrq( TX_TIMEOUT_VALUE );
+    while ( Radio.Poll( &event ) == true )
+    {
+      if ( ( event.Type == RADIO_EVENT_TX_DONE ) || ( event.Type == RADIO_EVENT_TX_TIMEOUT ) )
+      {
+        return event.Timestamp;
+      }
+    }
+  }
+}
+
+/*!
+   \brief Application filling the payload, 1 us per byte
+*/
+static void FillPayload( uint8_t counter )
+{
+  for ( uint8_t i = 0; i < PAYLOAD_SIZE; i++ )
+  {
+    Payload[i] = counter + i;
+  }
+  Channel.Advance( PAYLOAD_SIZE );
+}
+
+static Turnaround_t Measure( bool lazy, bool toRx, uint32_t cycles, uint32_t hostWork )
+{
+  TickTime_t txTimeout = { RADIO_TICK_SIZE_1000_US, TX_TIMEOUT_VALUE };
+  TickTime_t rxTimeout = { RADIO_TICK_SIZE_1000_US, RX_TIMEOUT_VALUE };
+  uint32_t ignored = Node.GetIgnoredCommands( );
+  Turnaround_t turnaround = { 0, 0, 0 };
+
+  Radio.SetLazyBusy( lazy );
+  FillPayload( 0 );
+  Radio.SendPayload( Payload, PAYLOAD_SIZE, txTimeout, 0 );
+  for ( uint32_t i = 0; i < cycles; i++ )
+  {
+    uint32_t edge = WaitTxDone( );
+
+    if ( toRx == true )
+    {
+      Radio.SetRx( rxTimeout );
+    }
+    else
+    {
+      FillPayload( i + 1 );
+      Radio.SendPayload( Payload, PAYLOAD_SIZE, txTimeout, 0 );
+    }
+    turnaround.Ready += Node.GetBusyUntil( ) - edge;
+    Channel.Advance( hostWork );
+    turnaround.Done += Channel.Now( ) - edge;
+
+    if ( toRx == true )
+    {
+      // No peer answers: back to TX for the next cycle
+      Radio.SetStandby( STDBY_RC );
+      FillPayload( i + 1 );
+      Radio.SendPayload( Payload, PAYLOAD_SIZE, txTimeout, 0 );
+    }
+  }
+  WaitTxDone( );
+  turnaround.IgnoredCommands = Node.GetIgnoredCommands( ) - ignored;
+  return turnaround;
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t cycles = ( argc > 1 ) ? atoi( argv[1] ) : 100;
+  uint32_t hostWork = ( argc > 2 ) ? atoi( argv[2] ) : 50;
+  ModulationParams_t modulationParams;
+  PacketParams_t packetParams;
+  uint32_t ignored = 0;
+
+  SimTransport_Attach( &Channel, &Node );
+  Radio.SetTransport( &SimTransport );
+  Radio.Init( NULL );
+  Radio.SetRegulatorMode( USE_DCDC );
+
+  modulationParams.PacketType = PACKET_TYPE_LORA;
+  modulationParams.Params.LoRa.SpreadingFactor = LORA_SF5;
+  modulationParams.Params.LoRa.Bandwidth = LORA_BW_1600;
+  modulationParams.Params.LoRa.CodingRate = LORA_CR_4_5;
+
+  packetParams.PacketType = PACKET_TYPE_LORA;
+  packetParams.Params.LoRa.PreambleLength = 12;
+  packetParams.Params.LoRa.HeaderType = LORA_PACKET_VARIABLE_LENGTH;
+  packetParams.Params.LoRa.PayloadLength = PAYLOAD_SIZE;
+  packetParams.Params.LoRa.Crc = LORA_CRC_ON;
+  packetParams.Params.LoRa.InvertIQ = LORA_IQ_NORMAL;
+
+  Radio.SetStandby( STDBY_RC );
+  Radio.SetPacketType( modulationParams.PacketType );
+  Radio.SetModulationParams( &modulationParams );
+  Radio.SetPacketParams( &packetParams );
+  Radio.SetRfFrequency( RF_FREQUENCY );
+  Radio.SetBufferBaseAddresses( 0x00, 0x00 );
+  Radio.SetTxParams( TX_OUTPUT_POWER, RADIO_RAMP_20_US );
+  Radio.SetDioIrqParams( IRQ_TX_DONE | IRQ_RX_TX_TIMEOUT, IRQ_TX_DONE | IRQ_RX_TX_TIMEOUT, IRQ_RADIO_NONE, IRQ_RADIO_NONE );
+
+  printf( "%u cycles, %u us of host work after each switch\n", cycles, hostWork );
+  printf( "turnaround  busy   radio ready [us]  host done [us]\n" );
+  for ( uint8_t i = 0; i < 2; i++ )
+  {
+    bool toRx = ( i == 0 );
+    Turnaround_t eager = Measure( false, toRx, cycles, hostWork );
+    Turnaround_t lazy = Measure( true, toRx, cycles, hostWork );
+
+    printf( "%-11s eager %16.1f %15.1f\n", toRx ? "TX to RX" : "TX to TX", ( double )eager.Ready / cycles, ( double )eager.Done / cycles );
+    printf( "%-11s lazy  %16.1f %15.1f\n", "", ( double )lazy.Ready / cycles, ( double )lazy.Done / cycles );
+    printf( "%-11s saved %16.1f %15.1f\n", "", ( ( double )eager.Ready - lazy.Ready ) / cycles, ( ( double )eager.Done - lazy.Done ) / cycles );
+    ignored += eager.IgnoredCommands + lazy.IgnoredCommands;
+  }
+  printf( "Ignored commands %u\n", ignored );
+  return ( ignored == 0 ) ? 0 : 1;
+}